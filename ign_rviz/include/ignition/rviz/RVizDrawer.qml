@@ -23,52 +23,13 @@ Rectangle {
   id: displayDrawer
   anchors.fill: parent
 
-  function onAction(action) {
+  function onAction(action, plugin) {
     switch(action) {
       case "loadPluginByTopic":
         loadPluginByTopic();
         break;
-      case "addAxesDisplay":
-        RViz.addAxesDisplay();
-        break;
-      case "addGrid3D":
-        RViz.addGrid3D();
-        break;
-      case "addGPSDisplay":
-        RViz.addGPSDisplay();
-        break;
-      case "addImageDisplay":
-        RViz.addImageDisplay();
-        break;
-      case "addLaserScanDisplay":
-        RViz.addLaserScanDisplay();
-        break;
-      case "addMarkerDisplay":
-        RViz.addMarkerDisplay();
-        break;
-      case "addMarkerArrayDisplay":
-        RViz.addMarkerArrayDisplay();
-        break;
-      case "addPathDisplay":
-        RViz.addPathDisplay();
-        break;
-      case "addPointStampedDisplay":
-        RViz.addPointStampedDisplay();
-        break;
-      case "addPolygonDisplay":
-        RViz.addPolygonDisplay();
-        break;
-      case "addPoseDisplay":
-        RViz.addPoseDisplay();
-        break;
-      case "addPoseArrayDisplay":
-        RViz.addPoseArrayDisplay();
-        break;
-      case "addRobotModelDisplay":
-        RViz.addRobotModelDisplay();
-        break;
-      case "addTFDisplay":
-        RViz.addTFDisplay();
+      case "addDisplay":
+        RViz.addDisplay(plugin);
         break;
       default:
         parent.onAction(action);
@@ -83,90 +44,105 @@ Rectangle {
       title: "Add By Topic"
       icon: "icons/Add.png"
       actionElement: "loadPluginByTopic"
+      plugin: ""
     }
 
     ListElement {
       title: "Axes"
       icon: "icons/Axes.png"
-      actionElement: "addAxesDisplay"
+      actionElement: "addDisplay"
+      plugin: "AxesDisplay"
     }
 
     ListElement {
       title: "Grid"
       icon: "icons/Grid.png"
-      actionElement: "addGrid3D"
+      actionElement: "addDisplay"
+      plugin: "Grid3D"
     }
 
     ListElement {
       title: "GPS"
       icon: "icons/NavSatFix.png"
-      actionElement: "addGPSDisplay"
+      actionElement: "addDisplay"
+      plugin: "GPSDisplay"
     }
 
     ListElement {
       title: "Image"
       icon: "icons/Image.png"
-      actionElement: "addImageDisplay"
+      actionElement: "addDisplay"
+      plugin: "ImageDisplay"
     }
 
     ListElement {
       title: "LaserScan"
       icon: "icons/LaserScan.png"
-      actionElement: "addLaserScanDisplay"
+      actionElement: "addDisplay"
+      plugin: "LaserScanDisplay"
     }
 
     ListElement {
       title: "Marker"
       icon: "icons/Marker.png"
-      actionElement: "addMarkerDisplay"
+      actionElement: "addDisplay"
+      plugin: "MarkerDisplay"
     }
 
     ListElement {
       title: "MarkerArray"
       icon: "icons/MarkerArray.png"
-      actionElement: "addMarkerArrayDisplay"
+      actionElement: "addDisplay"
+      plugin: "MarkerArrayDisplay"
     }
 
     ListElement {
       title: "Path"
       icon: "icons/Path.png"
-      actionElement: "addPathDisplay"
+      actionElement: "addDisplay"
+      plugin: "PathDisplay"
     }
 
     ListElement {
       title: "PointStamped"
       icon: "icons/PointStamped.png"
-      actionElement: "addPointStampedDisplay"
+      actionElement: "addDisplay"
+      plugin: "PointStampedDisplay"
     }
 
     ListElement {
       title: "Polygon"
       icon: "icons/Polygon.png"
-      actionElement: "addPolygonDisplay"
+      actionElement: "addDisplay"
+      plugin: "PolygonDisplay"
     }
 
     ListElement {
       title: "Pose"
       icon: "icons/Pose.png"
-      actionElement: "addPoseDisplay"
+      actionElement: "addDisplay"
+      plugin: "PoseDisplay"
     }
 
     ListElement {
       title: "PoseArray"
       icon: "icons/PoseArray.png"
-      actionElement: "addPoseArrayDisplay"
+      actionElement: "addDisplay"
+      plugin: "PoseArrayDisplay"
     }
 
     ListElement {
       title: "RobotModel"
       icon: "icons/RobotModel.png"
-      actionElement: "addRobotModelDisplay"
+      actionElement: "addDisplay"
+      plugin: "RobotModelDisplay"
     }
 
     ListElement {
       title: "TF"
       icon: "icons/TF.png"
-      actionElement: "addTFDisplay"
+      actionElement: "addDisplay"
+      plugin: "TFDisplay"
     }
   }
 
@@ -203,7 +179,7 @@ Rectangle {
         anchors.fill: parent
         hoverEnabled: true
         onClicked: {
-          displayDrawer.onAction(actionElement);
+          displayDrawer.onAction(actionElement, plugin);
           displayDrawer.parent.closeDrawer();
         }
       }
@@ -228,48 +204,7 @@ Rectangle {
    * @param[in] _msgType Message type
    */
   function loadPlugin(_name, _msgType) {
-    switch(_msgType) {
-      case "geometry_msgs/msg/PointStamped": {
-        RViz.addPointStampedDisplay(_name)
-        break;
-      }
-      case "geometry_msgs/msg/PolygonStamped": {
-        RViz.addPolygonDisplay(_name)
-        break;
-      }
-      case "geometry_msgs/msg/PoseStamped": {
-        RViz.addPoseDisplay(_name)
-        break;
-      }
-      case "geometry_msgs/msg/PoseArray": {
-        RViz.addPoseArrayDisplay(_name)
-        break;
-      }
-      case "nav_msgs/msg/Path": {
-        RViz.addPathDisplay(_name)
-        break;
-      }
-      case "sensor_msgs/msg/Image": {
-        RViz.addImageDisplay(_name)
-        break;
-      }
-      case "sensor_msgs/msg/LaserScan": {
-        RViz.addLaserScanDisplay(_name)
-        break;
-      }
-      case "visualization_msgs/msg/Marker": {
-        RViz.addMarkerDisplay(_name)
-        break;
-      }
-      case "visualization_msgs/msg/MarkerArray": {
-        RViz.addMarkerArrayDisplay(_name)
-        break;
-      }
-      case "sensor_msgs/msg/NavSatFix": {
-        RViz.addGPSDisplay(_name)
-        break;
-      }
-    }
+    RViz.addDisplayByType(_msgType, _name)
   }
 
   // Select topic window
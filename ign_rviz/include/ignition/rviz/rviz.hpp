@@ -23,20 +23,19 @@
 #endif
 
 #include <rclcpp/rclcpp.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 
 #include <ignition/rviz/plugins/message_display_base.hpp>
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace ignition
 {
 namespace rviz
 {
-template<typename MessageType>
-using DisplayPlugin = plugins::MessageDisplay<MessageType>;
-
 ////////////////////////////////////////////////////////////////////////////////
 /**
  * @brief Helper class to render ros topics in a list
@@ -109,102 +108,77 @@ public:
   Q_INVOKABLE void refreshTopicList() const;
 
   /**
-   * @brief Add Grid visual to Scene3D
-   */
-  Q_INVOKABLE void addGrid3D() const;
-
-  /**
-   * @brief Loads TF Visualization Plugin
-   */
-  Q_INVOKABLE void addTFDisplay() const;
-
-  /**
-   * @brief Loads LaserScan Visualization Plugin
-   * @param[in] _topic Topic name
-   */
-  Q_INVOKABLE void addLaserScanDisplay(const QString & _topic = "/scan") const;
-
-  /**
-   * @brief Loads GPS Visualization Plugin
-   * @param[in] _topic Topic name
-   */
-  Q_INVOKABLE void addGPSDisplay(const QString & _topic = "/gps") const;
-
-  /**
-   * @brief Loads Marker Visualization Plugin
-   * @param[in] _topic Topic name
-   */
-  Q_INVOKABLE void addMarkerDisplay(const QString & _topic = "/marker") const;
-
-  /**
-   * @brief Loads MarkerArray Visualization Plugin
-   * @param[in] _topic Topic name
-   */
-  Q_INVOKABLE void addMarkerArrayDisplay(const QString & _topic = "/marker_array") const;
-
-  /**
-   * @brief Loads PointStamped Visualization Plugin
-   * @param[in] _topic Topic name
+   * @brief Loads a display plugin
+   * @param[in] _plugin Plugin name, e.g. "LaserScanDisplay"
+   * @param[in] _topic Topic name, empty for the display default topic
    */
-  Q_INVOKABLE void addPointStampedDisplay(const QString & _topic = "/point") const;
+  Q_INVOKABLE void addDisplay(const QString & _plugin, const QString & _topic = "") const;
 
   /**
-   * @brief Loads Polygon Visualization Plugin
+   * @brief Loads the display plugin of a message type
+   * @param[in] _msgType Message type, e.g. "sensor_msgs/msg/LaserScan"
    * @param[in] _topic Topic name
    */
-  Q_INVOKABLE void addPolygonDisplay(const QString & _topic = "/polygon") const;
+  Q_INVOKABLE void addDisplayByType(const QString & _msgType, const QString & _topic) const;
 
   /**
-   * @brief Loads Pose Visualization Plugin
-   * @param[in] _topic Topic name
-   */
-  Q_INVOKABLE void addPoseDisplay(const QString & _topic = "/pose") const;
-
-  /**
-   * @brief Loads PoseArray Visualization Plugin
-   * @param[in] _topic Topic name
-   */
-  Q_INVOKABLE void addPoseArrayDisplay(const QString & _topic = "/pose_array") const;
-
-  /**
-   * @brief Loads Path Visualization Plugin
-   * @param[in] _topic Topic name
+   * @brief Initialize ignition RViz ROS node and frame manager
+   * @param[in] _options: Node options, e.g. to enable intra-process communication
+   * @throws anything rclcpp::exceptions::throw_from_rcl_error can throw.
    */
-  Q_INVOKABLE void addPathDisplay(const QString & _topic = "/path") const;
+  void init_ros(const rclcpp::NodeOptions & _options = rclcpp::NodeOptions());
 
   /**
-   * @brief Loads RobotModel Dispaly Plugin
+   * @brief Returns ignition RViz ROS node
+   * @return ROS Node shared pointer
    */
-  Q_INVOKABLE void addRobotModelDisplay() const;
+  rclcpp::Node::SharedPtr get_node();
 
+private:
   /**
-   * @brief Loads Image Display Plugin
-   * @param[in] _topic Topic name
+   * @brief Publish message statistics of all displays on /diagnostics
    */
-  Q_INVOKABLE void addImageDisplay(const QString & _topic = "/image") const;
+  void publishDiagnostics();
 
   /**
-   * @brief Loads Axes Visualization Plugin
+   * @brief Register a display plugin
+   * @param[in] _plugin Plugin name
+   * @param[in] _msgType Displayed message type, empty if not listed by topic
+   * @param[in] _defaultTopic Topic subscribed when none is given, empty for no subscription
    */
-  Q_INVOKABLE void addAxesDisplay() const;
+  void registerDisplay(
+    const std::string & _plugin, const std::string & _msgType,
+    const std::string & _defaultTopic);
 
   /**
-   * @brief Initialize ignition RViz ROS node and frame manager
-   * @throws anything rclcpp::exceptions::throw_from_rcl_error can throw.
+   * @brief Load a plugin
+   * @param[in] _plugin Plugin name
+   * @return Loaded display, nullptr if loading failed or the plugin is not a display
    */
-  void init_ros();
+  plugins::MessageDisplayBase * loadDisplay(const std::string & _plugin) const;
 
   /**
-   * @brief Returns ignition RViz ROS node
-   * @return ROS Node shared pointer
+   * @brief Share common resources with a loaded display and subscribe to its topic
+   * @param[in] _display Loaded display
+   * @param[in] _topic Topic name, empty for no subscription
    */
-  rclcpp::Node::SharedPtr get_node();
+  void setupDisplay(plugins::MessageDisplayBase * _display, const std::string & _topic) const;
 
 private:
   // Data Members
   rclcpp::Node::SharedPtr node;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnosticsPublisher;
+  QTimer * diagnosticsTimer;
   std::shared_ptr<common::FrameManager> frameManager;
-  std::vector<std::string> supportedDisplays;
+  std::shared_ptr<common::WorkerPool> workerPool;
+  std::shared_ptr<common::RenderBudget> renderBudget;
+  std::shared_ptr<common::TopicCache> topicCache;
+
+  // Plugin name to default topic of all registered displays
+  std::unordered_map<std::string, std::string> displayPlugins;
+
+  // Message type to plugin name
+  std::unordered_map<std::string, std::string> displayTypes;
 
   // Topic model
   TopicModel * topicModel;
@@ -15,7 +15,9 @@
 #include <ament_index_cpp/get_package_share_directory.hpp>
 #include <ament_index_cpp/get_package_prefix.hpp>
 #include <ignition/common/Console.hh>
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #ifndef Q_MOC_RUN
   #include <ignition/gui/Application.hh>
@@ -29,6 +31,11 @@ int main(int argc, char ** argv)
 {
   rclcpp::init(argc, argv);
 
+  // Zero-copy delivery from publishers composed in the same process
+  const std::vector<std::string> args = rclcpp::remove_ros_arguments(argc, argv);
+  const bool intraProcess =
+    std::find(args.begin(), args.end(), "--intra-process") != args.end();
+
   ignition::common::Console::SetVerbosity(4);
 
   ignition::gui::Application app(argc, argv);
@@ -41,8 +48,14 @@ int main(int argc, char ** argv)
 
   ignition::rviz::RViz rviz;
 
-  rviz.init_ros();
-  rclcpp::executors::MultiThreadedExecutor executor;
+  rviz.init_ros(rclcpp::NodeOptions().use_intra_process_comms(intraProcess));
+
+  // Displays and tf sources have their own callback groups and run in parallel,
+  // zero threads uses one thread per core
+  const int64_t executorThreads =
+    rviz.get_node()->declare_parameter("executor_threads", static_cast<int64_t>(0));
+  rclcpp::executors::MultiThreadedExecutor executor(
+    rclcpp::ExecutorOptions(), static_cast<size_t>(std::max<int64_t>(executorThreads, 0)));
   executor.add_node(rviz.get_node());
   std::thread executor_thread(std::bind(
       &rclcpp::executors::MultiThreadedExecutor::spin,
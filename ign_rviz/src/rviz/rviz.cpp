@@ -14,21 +14,13 @@
 
 #include "ignition/rviz/rviz.hpp"
 
-#include <geometry_msgs/msg/point_stamped.hpp>
-#include <geometry_msgs/msg/polygon_stamped.hpp>
-#include <geometry_msgs/msg/pose_stamped.hpp>
-#include <geometry_msgs/msg/pose_array.hpp>
-#include <nav_msgs/msg/path.hpp>
-#include <sensor_msgs/msg/image.hpp>
-#include <sensor_msgs/msg/laser_scan.hpp>
-#include <sensor_msgs/msg/nav_sat_fix.hpp>
-#include <std_msgs/msg/string.hpp>
-#include <tf2_msgs/msg/tf_message.hpp>
-#include <visualization_msgs/msg/marker.hpp>
-#include <visualization_msgs/msg/marker_array.hpp>
+#include <QTimer>
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ignition
@@ -75,21 +67,28 @@ QHash<int, QByteArray> TopicModel::roleNames() const
 
 ////////////////////////////////////////////////////////////////////////////////
 RViz::RViz()
+: diagnosticsTimer(nullptr)
 {
   this->topicModel = new TopicModel();
 
-  this->supportedDisplays = {
-    "geometry_msgs/msg/PointStamped",
-    "geometry_msgs/msg/PolygonStamped",
-    "geometry_msgs/msg/PoseStamped",
-    "geometry_msgs/msg/PoseArray",
-    "nav_msgs/msg/Path",
-    "sensor_msgs/msg/Image",
-    "sensor_msgs/msg/LaserScan",
-    "sensor_msgs/msg/NavSatFix",
-    "visualization_msgs/msg/Marker",
-    "visualization_msgs/msg/MarkerArray"
-  };
+  // Displays of message types, listed when adding a display by topic
+  this->registerDisplay("PointStampedDisplay", "geometry_msgs/msg/PointStamped", "/point");
+  this->registerDisplay("PolygonDisplay", "geometry_msgs/msg/PolygonStamped", "/polygon");
+  this->registerDisplay("PoseDisplay", "geometry_msgs/msg/PoseStamped", "/pose");
+  this->registerDisplay("PoseArrayDisplay", "geometry_msgs/msg/PoseArray", "/pose_array");
+  this->registerDisplay("PathDisplay", "nav_msgs/msg/Path", "/path");
+  this->registerDisplay("ImageDisplay", "sensor_msgs/msg/Image", "/image");
+  this->registerDisplay("LaserScanDisplay", "sensor_msgs/msg/LaserScan", "/scan");
+  this->registerDisplay("GPSDisplay", "sensor_msgs/msg/NavSatFix", "/gps");
+  this->registerDisplay("MarkerDisplay", "visualization_msgs/msg/Marker", "/marker");
+  this->registerDisplay(
+    "MarkerArrayDisplay", "visualization_msgs/msg/MarkerArray", "/marker_array");
+
+  // Displays without message type
+  this->registerDisplay("RobotModelDisplay", "", "/robot_description");
+  this->registerDisplay("TFDisplay", "", "");
+  this->registerDisplay("AxesDisplay", "", "");
+  this->registerDisplay("Grid3D", "", "");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -102,268 +101,242 @@ TopicModel * RViz::getTopicModel() const
 void RViz::refreshTopicList() const
 {
   this->topicModel->removeRows(0, this->topicModel->rowCount());
-  auto topics = this->node->get_topic_names_and_types();
-  for (const auto & topic : topics) {
-    for (const auto & topicType : topic.second) {
-      if (std::find(
-          supportedDisplays.begin(), supportedDisplays.end(),
-          topicType) != this->supportedDisplays.end())
-      {
-        this->topicModel->addTopic(topic.first, topicType);
-      }
+
+  // Topic and message type of all supported topics
+  std::vector<std::pair<std::string, std::string>> topics;
+  for (const auto & displayType : this->displayTypes) {
+    for (const auto & topic : this->topicCache->getTopics(displayType.first)) {
+      topics.emplace_back(topic, displayType.first);
     }
   }
-}
 
-////////////////////////////////////////////////////////////////////////////////
-void RViz::addGrid3D() const
-{
-  ignition::gui::App()->LoadPlugin("Grid3D");
-}
-
-////////////////////////////////////////////////////////////////////////////////
-void RViz::addTFDisplay() const
-{
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("TFDisplay")) {
-    auto tfDisplayPlugins =
-      ignition::gui::App()->findChildren<DisplayPlugin<tf2_msgs::msg::TFMessage> *>();
-    int tfDisplayCount = tfDisplayPlugins.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    tfDisplayPlugins[tfDisplayCount]->initialize(this->node);
-    tfDisplayPlugins[tfDisplayCount]->setFrameManager(this->frameManager);
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      tfDisplayPlugins[tfDisplayCount]);
+  // List topics in alphabetical order
+  std::sort(topics.begin(), topics.end());
+  for (const auto & topic : topics) {
+    this->topicModel->addTopic(topic.first, topic.second);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void RViz::addLaserScanDisplay(const QString & _topic) const
-{
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("LaserScanDisplay")) {
-    auto laserScanPlugin =
-      ignition::gui::App()->findChildren<DisplayPlugin<sensor_msgs::msg::LaserScan> *>();
-    int pluginCount = laserScanPlugin.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    laserScanPlugin[pluginCount]->initialize(this->node);
-    laserScanPlugin[pluginCount]->setTopic(_topic.toStdString());
-    laserScanPlugin[pluginCount]->setFrameManager(this->frameManager);
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      laserScanPlugin[pluginCount]);
-  }
-}
-////////////////////////////////////////////////////////////////////////////////
-void RViz::addGPSDisplay(const QString & _topic) const
+void RViz::registerDisplay(
+  const std::string & _plugin, const std::string & _msgType,
+  const std::string & _defaultTopic)
 {
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("GPSDisplay")) {
-    auto gpsDisplay =
-      ignition::gui::App()->findChildren<DisplayPlugin<sensor_msgs::msg::NavSatFix> *>();
-    int pluginCount = gpsDisplay.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    gpsDisplay[pluginCount]->initialize(this->node);
-    gpsDisplay[pluginCount]->setTopic(_topic.toStdString());
+  this->displayPlugins[_plugin] = _defaultTopic;
+  if (!_msgType.empty()) {
+    this->displayTypes[_msgType] = _plugin;
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void RViz::addMarkerDisplay(const QString & _topic) const
+void RViz::addDisplay(const QString & _plugin, const QString & _topic) const
 {
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("MarkerDisplay")) {
-    auto markerDisplay =
-      ignition::gui::App()->findChildren<DisplayPlugin<visualization_msgs::msg::Marker> *>();
-    int pluginCount = markerDisplay.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    markerDisplay[pluginCount]->initialize(this->node);
-    markerDisplay[pluginCount]->setTopic(_topic.toStdString());
-    markerDisplay[pluginCount]->setFrameManager(this->frameManager);
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      markerDisplay[pluginCount]);
+  auto it = this->displayPlugins.find(_plugin.toStdString());
+  if (it == this->displayPlugins.end()) {
+    RCLCPP_ERROR(
+      this->node->get_logger(), "Unknown display: %s", _plugin.toStdString().c_str());
+    return;
   }
-}
 
-////////////////////////////////////////////////////////////////////////////////
-void RViz::addMarkerArrayDisplay(const QString & _topic) const
-{
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("MarkerArrayDisplay")) {
-    auto markerArrayDisplay =
-      ignition::gui::App()->findChildren<DisplayPlugin<visualization_msgs::msg::MarkerArray> *>();
-    int pluginCount = markerArrayDisplay.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    markerArrayDisplay[pluginCount]->initialize(this->node);
-    markerArrayDisplay[pluginCount]->setTopic(_topic.toStdString());
-    markerArrayDisplay[pluginCount]->setFrameManager(this->frameManager);
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      markerArrayDisplay[pluginCount]);
-  }
-}
+  const std::string topic = _topic.isEmpty() ? it->second : _topic.toStdString();
 
-////////////////////////////////////////////////////////////////////////////////
-void RViz::addPointStampedDisplay(const QString & _topic) const
-{
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("PointStampedDisplay")) {
-    auto pointStampedPlugin =
-      ignition::gui::App()->findChildren<DisplayPlugin<geometry_msgs::msg::PointStamped> *>();
-    int pluginCount = pointStampedPlugin.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    pointStampedPlugin[pluginCount]->initialize(this->node);
-    pointStampedPlugin[pluginCount]->setTopic(_topic.toStdString());
-    pointStampedPlugin[pluginCount]->setFrameManager(this->frameManager);
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      pointStampedPlugin[pluginCount]);
+  auto display = this->loadDisplay(it->first);
+  if (display != nullptr) {
+    this->setupDisplay(display, topic);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void RViz::addPolygonDisplay(const QString & _topic) const
+void RViz::addDisplayByType(const QString & _msgType, const QString & _topic) const
 {
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("PolygonDisplay")) {
-    auto polygonPlugin =
-      ignition::gui::App()->findChildren<DisplayPlugin<geometry_msgs::msg::PolygonStamped> *>();
-    int pluginCount = polygonPlugin.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    polygonPlugin[pluginCount]->initialize(this->node);
-    polygonPlugin[pluginCount]->setTopic(_topic.toStdString());
-    polygonPlugin[pluginCount]->setFrameManager(this->frameManager);
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      polygonPlugin[pluginCount]);
+  auto it = this->displayTypes.find(_msgType.toStdString());
+  if (it == this->displayTypes.end()) {
+    RCLCPP_ERROR(
+      this->node->get_logger(), "No display for message type: %s",
+      _msgType.toStdString().c_str());
+    return;
   }
+
+  this->addDisplay(QString::fromStdString(it->second), _topic);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void RViz::addPoseDisplay(const QString & _topic) const
+plugins::MessageDisplayBase * RViz::loadDisplay(const std::string & _plugin) const
 {
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("PoseDisplay")) {
-    auto posePlugin =
-      ignition::gui::App()->findChildren<DisplayPlugin<geometry_msgs::msg::PoseStamped> *>();
-    int pluginCount = posePlugin.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    posePlugin[pluginCount]->initialize(this->node);
-    posePlugin[pluginCount]->setTopic(_topic.toStdString());
-    posePlugin[pluginCount]->setFrameManager(this->frameManager);
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      posePlugin[pluginCount]);
+  // The application reports the unique name of every plugin it adds
+  QString objectName;
+  auto connection = connect(
+    ignition::gui::App(), &ignition::gui::Application::PluginAdded,
+    [&objectName](const QString & _objectName) {
+      objectName = _objectName;
+    });
+  const bool loaded = ignition::gui::App()->LoadPlugin(_plugin);
+  disconnect(connection);
+
+  if (!loaded || objectName.isEmpty()) {
+    return nullptr;
   }
+
+  // Plugins which are not displays, e.g. Grid3D, need no setup
+  auto plugin = ignition::gui::App()->PluginByName(objectName.toStdString());
+  return qobject_cast<plugins::MessageDisplayBase *>(plugin.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void RViz::addPoseArrayDisplay(const QString & _topic) const
+void RViz::setupDisplay(plugins::MessageDisplayBase * _display, const std::string & _topic) const
 {
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("PoseArrayDisplay")) {
-    auto poseArrayPlugin =
-      ignition::gui::App()->findChildren<DisplayPlugin<geometry_msgs::msg::PoseArray> *>();
-    int pluginCount = poseArrayPlugin.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    poseArrayPlugin[pluginCount]->initialize(this->node);
-    poseArrayPlugin[pluginCount]->setTopic(_topic.toStdString());
-    poseArrayPlugin[pluginCount]->setFrameManager(this->frameManager);
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      poseArrayPlugin[pluginCount]);
+  _display->initialize(this->node);
+  _display->setTopicCache(this->topicCache);
+  _display->setRenderBudget(this->renderBudget);
+  _display->setWorkerPool(this->workerPool);
+  _display->setFrameManager(this->frameManager);
+
+  if (!_topic.empty()) {
+    _display->setTopic(_topic);
   }
+
+  ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(_display);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void RViz::addPathDisplay(const QString & _topic) const
+void RViz::init_ros(const rclcpp::NodeOptions & _options)
 {
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("PathDisplay")) {
-    auto pathPlugin =
-      ignition::gui::App()->findChildren<DisplayPlugin<nav_msgs::msg::Path> *>();
-    int pluginCount = pathPlugin.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    pathPlugin[pluginCount]->initialize(this->node);
-    pathPlugin[pluginCount]->setTopic(_topic.toStdString());
-    pathPlugin[pluginCount]->setFrameManager(this->frameManager);
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      pathPlugin[pluginCount]);
+  this->node = std::make_shared<rclcpp::Node>("ignition_rviz", _options);
+  this->frameManager = std::make_shared<common::FrameManager>(this->node);
+  this->frameManager->setFixedFrame("world");
+
+  // Topic list shared by all displays, updated on graph changes
+  this->topicCache = std::make_shared<common::TopicCache>(this->node);
+
+  // Evict frames that are no longer published, disabled by default
+  const double frameTimeout = this->node->declare_parameter("frame_timeout", 0.0);
+  if (frameTimeout > 0.0) {
+    this->frameManager->setFrameTimeout(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(frameTimeout)));
   }
-}
 
-////////////////////////////////////////////////////////////////////////////////
-void RViz::addRobotModelDisplay() const
-{
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("RobotModelDisplay")) {
-    auto robotModelPlugin =
-      ignition::gui::App()->findChildren<DisplayPlugin<std_msgs::msg::String> *>();
-    int pluginCount = robotModelPlugin.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    robotModelPlugin[pluginCount]->initialize(this->node);
-    robotModelPlugin[pluginCount]->setFrameManager(this->frameManager);
-    robotModelPlugin[pluginCount]->setTopic("/robot_description");
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      robotModelPlugin[pluginCount]);
+  // Additional tf topics as "topic:prefix", topics ending in _static are latched
+  const auto tfSources =
+    this->node->declare_parameter("tf_sources", std::vector<std::string>());
+  for (const auto & source : tfSources) {
+    const size_t separator = source.find(':');
+    const std::string topic = source.substr(0, separator);
+    const std::string prefix =
+      (separator == std::string::npos) ? "" : source.substr(separator + 1);
+    const std::string staticSuffix = "_static";
+    const bool isStatic = topic.size() >= staticSuffix.size() &&
+      topic.compare(topic.size() - staticSuffix.size(), staticSuffix.size(), staticSuffix) == 0;
+
+    if (!this->frameManager->addTfSource(topic, prefix, isStatic)) {
+      RCLCPP_WARN(this->node->get_logger(), "Ignoring duplicate tf source %s", topic.c_str());
+    }
   }
-}
 
-////////////////////////////////////////////////////////////////////////////////
-void RViz::addImageDisplay(const QString & _topic) const
-{
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("ImageDisplay")) {
-    auto imageDisplayPlugin =
-      ignition::gui::App()->findChildren<DisplayPlugin<sensor_msgs::msg::Image> *>();
-    int pluginCount = imageDisplayPlugin.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    imageDisplayPlugin[pluginCount]->initialize(this->node);
-    imageDisplayPlugin[pluginCount]->setTopic(_topic.toStdString());
+  // Threads converting messages for displays, zero to match the hardware
+  const int workerThreads = this->node->declare_parameter("worker_threads", 0);
+  this->workerPool = std::make_shared<common::WorkerPool>(std::max(workerThreads, 0));
+
+  // Display update time per frame, displays over budget are skipped by priority
+  const double frameBudget = this->node->declare_parameter("frame_budget", 0.008);
+  this->renderBudget = std::make_shared<common::RenderBudget>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(frameBudget)));
+
+  // Installed before displays, so it is notified after them on every frame
+  ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
+    this->renderBudget.get());
+
+  // Eager mode computes frame poses on ingest, pull mode resolves frames only
+  // when displays request them, with a buffer lookup on the render thread
+  const bool framePullMode = this->node->declare_parameter("frame_pull_mode", false);
+  if (framePullMode) {
+    this->frameManager->setPullMode(true);
   }
-}
+  ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
+    this->frameManager.get());
 
-////////////////////////////////////////////////////////////////////////////////
-void RViz::addAxesDisplay() const
-{
-  // Load plugin
-  if (ignition::gui::App()->LoadPlugin("AxesDisplay")) {
-    auto axes_plugins =
-      ignition::gui::App()->findChildren<ignition::rviz::plugins::MessageDisplayBase *>();
-    int axes_plugin_count = axes_plugins.size() - 1;
-
-    // Set frame manager and install event filter for recently added plugin
-    axes_plugins[axes_plugin_count]->setFrameManager(this->frameManager);
+  // Publish display statistics from the GUI thread, which owns the plugins
+  this->diagnosticsPublisher =
+    this->node->create_publisher<diagnostic_msgs::msg::DiagnosticArray>("/diagnostics", 10);
+  this->diagnosticsTimer = new QTimer(this);
+  connect(this->diagnosticsTimer, &QTimer::timeout, this, &RViz::publishDiagnostics);
+  this->diagnosticsTimer->start(1000);
+
+  // Load Global Options plugin
+  auto globalOptionsPlugin = this->loadDisplay("GlobalOptions");
+  if (globalOptionsPlugin != nullptr) {
+    // Set frame manager and install event filter
+    globalOptionsPlugin->setFrameManager(this->frameManager);
     ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      axes_plugins[axes_plugin_count]);
+      globalOptionsPlugin);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void RViz::init_ros()
+void RViz::publishDiagnostics()
 {
-  this->node = std::make_shared<rclcpp::Node>("ignition_rviz");
-  this->frameManager = std::make_shared<common::FrameManager>(this->node);
-  this->frameManager->setFixedFrame("world");
+  diagnostic_msgs::msg::DiagnosticArray diagnostics;
+  diagnostics.header.stamp = this->node->now();
 
-  // Load Global Options plugin
-  if (ignition::gui::App()->LoadPlugin("GlobalOptions")) {
-    auto globalOptionsPlugin =
-      ignition::gui::App()->findChild<ignition::rviz::plugins::MessageDisplayBase *>();
+  auto displays = ignition::gui::App()->findChildren<plugins::MessageDisplayBase *>();
+  for (const auto display : displays) {
+    const std::string topic = display->getTopicName();
 
-    // Set frame manager and install
-    globalOptionsPlugin->setFrameManager(this->frameManager);
+    // Skip displays without subscription
+    if (topic.empty()) {
+      continue;
+    }
 
-    // Install event filter
-    ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->installEventFilter(
-      globalOptionsPlugin);
+    diagnostic_msgs::msg::DiagnosticStatus status;
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+    status.name = "ign_rviz: " + display->Title();
+    status.hardware_id = topic;
+
+    const auto addValue = [&status](const std::string & _key, double _value) {
+        diagnostic_msgs::msg::KeyValue keyValue;
+        keyValue.key = _key;
+        keyValue.value = std::to_string(_value);
+        status.values.push_back(keyValue);
+      };
+
+    addValue("Message rate (Hz)", display->getMessageRate());
+    addValue("Stamp latency (ms)", display->getStampLatency());
+    addValue("Render latency (ms)", display->getRenderLatency());
+    addValue("Dropped messages", display->getDroppedMessages());
+
+    if (display->getMessageRate() == 0.0) {
+      status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+      status.message = "No messages received";
+    }
+
+    diagnostics.status.push_back(status);
   }
+
+  // Frame budget shared by all displays
+  diagnostic_msgs::msg::DiagnosticStatus budgetStatus;
+  budgetStatus.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  budgetStatus.name = "ign_rviz: Render budget";
+
+  diagnostic_msgs::msg::KeyValue frameTime;
+  frameTime.key = "Display update time (ms)";
+  frameTime.value = std::to_string(this->renderBudget->getLastFrameTime().count() / 1e6);
+  budgetStatus.values.push_back(frameTime);
+
+  diagnostic_msgs::msg::KeyValue skipped;
+  skipped.key = "Skipped updates";
+  skipped.value = std::to_string(this->renderBudget->getSkippedUpdates());
+  budgetStatus.values.push_back(skipped);
+
+  const auto budget = this->renderBudget->getBudget();
+  if (budget.count() > 0 && this->renderBudget->getLastFrameTime() > budget) {
+    budgetStatus.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+    budgetStatus.message = "Display updates exceed the frame budget";
+  }
+
+  diagnostics.status.push_back(budgetStatus);
+
+  this->diagnosticsPublisher->publish(diagnostics);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,411 @@
+// Copyright (c) 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <ignition/gui/GuiEvents.hh>
+#include <rclcpp/rclcpp.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ignition/rviz/common/frame_manager.hpp"
+
+namespace
+{
+// Bytes currently allocated through operator new by counting threads, used to
+// measure memory per frame
+std::atomic<int64_t> allocatedBytes(0);
+
+// Set on the benchmark thread while measuring. Allocations of the listener and
+// executor threads are not counted.
+thread_local bool countAllocations = false;
+
+// Allocation header, keeps the returned pointer aligned for any type
+constexpr size_t kHeaderSize = alignof(std::max_align_t);
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+void * operator new(size_t _size)
+{
+  void * ptr = std::malloc(_size + kHeaderSize);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  // Store the counted size, so that frees on any thread subtract exactly what was added
+  const size_t counted = countAllocations ? _size : 0;
+  *static_cast<size_t *>(ptr) = counted;
+  allocatedBytes += counted;
+  return static_cast<char *>(ptr) + kHeaderSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete(void * _ptr) noexcept
+{
+  if (!_ptr) {
+    return;
+  }
+  void * ptr = static_cast<char *>(_ptr) - kHeaderSize;
+  allocatedBytes -= *static_cast<size_t *>(ptr);
+  std::free(ptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete(void * _ptr, size_t /*_size*/) noexcept
+{
+  operator delete(_ptr);
+}
+
+namespace ignition
+{
+namespace rviz
+{
+namespace common
+{
+/**
+ * @brief FrameManager with transform callbacks exposed, fed directly without a ROS graph
+ */
+class BenchmarkFrameManager : public FrameManager
+{
+public:
+  using FrameManager::FrameManager;
+  using FrameManager::tf_callback;
+  using FrameManager::tf_source_callback;
+
+  /**
+   * @brief Feed transforms like the tf listener and the /tf subscription do
+   * @param[in] _msg: Transform message
+   */
+  void receive(const tf2_msgs::msg::TFMessage::SharedPtr _msg)
+  {
+    this->tf_source_callback(_msg, "/tf", "", false);
+  }
+
+  /**
+   * @brief Start a new render tick
+   */
+  void renderTick()
+  {
+    gui::events::Render event;
+    this->eventFilter(&this->renderTarget, &event);
+  }
+
+private:
+  // Receives the frame events posted on render ticks
+  QObject renderTarget;
+};
+
+/**
+ * @brief Synthetic tf tree
+ */
+struct SyntheticTree
+{
+  /// One transform per frame, rooted at "world"
+  tf2_msgs::msg::TFMessage::SharedPtr msg;
+
+  /// Names of all non-root frames
+  std::vector<std::string> frames;
+
+  /// Number of edges from the root to the deepest frame
+  int depth = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Breadth first tree of _frameCount frames below "world", every frame having
+ * at most _fanOut children. A fan-out of one gives a chain.
+ */
+SyntheticTree createTree(int _frameCount, int _fanOut)
+{
+  SyntheticTree tree;
+  tree.msg = std::make_shared<tf2_msgs::msg::TFMessage>();
+  tree.msg->transforms.reserve(_frameCount);
+  tree.frames.reserve(_frameCount);
+
+  std::vector<int> depths;
+  depths.reserve(_frameCount);
+
+  for (int i = 0; i < _frameCount; ++i) {
+    const int parent = (i == 0) ? -1 : (i - 1) / _fanOut;
+
+    geometry_msgs::msg::TransformStamped transform;
+    transform.header.frame_id = (parent < 0) ? "world" : tree.frames[parent];
+    transform.child_frame_id = "frame_" + std::to_string(i);
+    transform.transform.translation.x = 1.0;
+    transform.transform.rotation.z = 0.0998334;
+    transform.transform.rotation.w = 0.9950042;
+
+    tree.frames.push_back(transform.child_frame_id);
+    tree.msg->transforms.push_back(transform);
+
+    depths.push_back((parent < 0) ? 1 : depths[parent] + 1);
+    tree.depth = std::max(tree.depth, depths.back());
+  }
+
+  return tree;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Registers every combination of the given argument values
+ */
+void argsProduct(
+  benchmark::internal::Benchmark * _benchmark,
+  const std::vector<std::vector<int64_t>> & _values)
+{
+  std::vector<size_t> index(_values.size(), 0);
+
+  while (true) {
+    std::vector<int64_t> args;
+    for (size_t i = 0; i < _values.size(); ++i) {
+      args.push_back(_values[i][index[i]]);
+    }
+    _benchmark->Args(args);
+
+    // Advance the last argument first
+    size_t i = _values.size();
+    while (i > 0 && ++index[i - 1] == _values[i - 1].size()) {
+      index[--i] = 0;
+    }
+    if (i == 0) {
+      return;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void setStamp(tf2_msgs::msg::TFMessage & _msg, int64_t _nanoseconds)
+{
+  for (auto & transform : _msg.transforms) {
+    transform.header.stamp.sec = static_cast<int32_t>(_nanoseconds / 1000000000);
+    transform.header.stamp.nanosec = static_cast<uint32_t>(_nanoseconds % 1000000000);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<BenchmarkFrameManager> createFrameManager(bool _pullMode)
+{
+  static auto node = std::make_shared<rclcpp::Node>("frame_manager_benchmark");
+
+  auto frameManager = std::make_shared<BenchmarkFrameManager>(node);
+  frameManager->setFixedFrame("world");
+  frameManager->setPullMode(_pullMode);
+
+  return frameManager;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Latency of a transform message updating every frame of the tree, followed by
+ * a render tick reading every frame pose. The tf buffer is filled as by the
+ * listener, so pull mode includes the buffer lookups of the render side.
+ * Arguments: frame count, fan-out, pull mode.
+ */
+void BM_TfCallback(benchmark::State & _state)
+{
+  SyntheticTree tree = createTree(_state.range(0), _state.range(1));
+  auto frameManager = createFrameManager(_state.range(2) != 0);
+
+  ignition::math::Pose3d pose;
+  int64_t stamp = 0;
+  for (auto _ : _state) {
+    setStamp(*tree.msg, ++stamp);
+    frameManager->receive(tree.msg);
+
+    frameManager->renderTick();
+    for (const auto & frame : tree.frames) {
+      benchmark::DoNotOptimize(frameManager->getFramePose(frame, pose));
+    }
+  }
+
+  _state.counters["depth"] = tree.depth;
+  _state.SetItemsProcessed(_state.iterations() * tree.frames.size());
+}
+BENCHMARK(BM_TfCallback)
+->ArgNames({"frames", "fan_out", "pull"})
+->Apply(
+  [](benchmark::internal::Benchmark * _benchmark)
+  {
+    argsProduct(_benchmark, {{10, 100, 1000}, {1, 2, 8}, {0, 1}});
+  })
+->Unit(benchmark::kMicrosecond);
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Latency of a transform callback updating a single leaf frame.
+ * Arguments: frame count, fan-out.
+ */
+void BM_TfCallbackSingleFrame(benchmark::State & _state)
+{
+  SyntheticTree tree = createTree(_state.range(0), _state.range(1));
+  auto frameManager = createFrameManager(false);
+  frameManager->tf_callback(tree.msg);
+
+  auto msg = std::make_shared<tf2_msgs::msg::TFMessage>();
+  msg->transforms.push_back(tree.msg->transforms.back());
+
+  int64_t stamp = 0;
+  for (auto _ : _state) {
+    setStamp(*msg, ++stamp);
+    frameManager->tf_callback(msg);
+  }
+
+  _state.counters["depth"] = tree.depth;
+}
+BENCHMARK(BM_TfCallbackSingleFrame)
+->ArgNames({"frames", "fan_out"})
+->Apply(
+  [](benchmark::internal::Benchmark * _benchmark)
+  {
+    argsProduct(_benchmark, {{100, 1000, 10000}, {1, 8}});
+  })
+->Unit(benchmark::kMicrosecond);
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Throughput of getFramePose while transforms arrive at a fixed rate and
+ * other threads query poses concurrently.
+ * Arguments: frame count, tf rate in Hz (zero for none), concurrent readers.
+ */
+void BM_GetFramePose(benchmark::State & _state)
+{
+  SyntheticTree tree = createTree(_state.range(0), 4);
+  auto frameManager = createFrameManager(false);
+  frameManager->tf_callback(tree.msg);
+
+  std::atomic<bool> running(true);
+  std::vector<std::thread> threads;
+
+  // Transform publisher
+  const int64_t rate = _state.range(1);
+  if (rate > 0) {
+    threads.emplace_back(
+      [&]()
+      {
+        auto msg = std::make_shared<tf2_msgs::msg::TFMessage>(*tree.msg);
+        const auto period = std::chrono::nanoseconds(1000000000 / rate);
+        auto next = std::chrono::steady_clock::now();
+        int64_t stamp = 0;
+
+        while (running) {
+          setStamp(*msg, ++stamp);
+          frameManager->tf_callback(msg);
+          next += period;
+          std::this_thread::sleep_until(next);
+        }
+      });
+  }
+
+  // Concurrent readers
+  for (int64_t i = 0; i < _state.range(2); ++i) {
+    threads.emplace_back(
+      [&, i]()
+      {
+        ignition::math::Pose3d pose;
+        size_t frame = i;
+        while (running) {
+          frameManager->getFramePose(tree.frames[frame++ % tree.frames.size()], pose);
+        }
+      });
+  }
+
+  ignition::math::Pose3d pose;
+  size_t frame = 0;
+  for (auto _ : _state) {
+    benchmark::DoNotOptimize(
+      frameManager->getFramePose(tree.frames[frame++ % tree.frames.size()], pose));
+  }
+
+  running = false;
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  _state.SetItemsProcessed(_state.iterations());
+}
+BENCHMARK(BM_GetFramePose)
+->ArgNames({"frames", "tf_hz", "readers"})
+->Apply(
+  [](benchmark::internal::Benchmark * _benchmark)
+  {
+    argsProduct(_benchmark, {{100, 1000}, {0, 100, 1000}, {0, 3, 7}});
+  })
+->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Memory held by FrameManager per frame once a tree has been received.
+ * Arguments: frame count, fan-out.
+ */
+void BM_MemoryPerFrame(benchmark::State & _state)
+{
+  SyntheticTree tree = createTree(_state.range(0), _state.range(1));
+
+  int64_t bytes = 0;
+  for (auto _ : _state) {
+    // The node, listener, subscriptions and buffer are not part of the per frame cost
+    _state.PauseTiming();
+    auto frameManager = createFrameManager(false);
+    const int64_t before = allocatedBytes;
+    _state.ResumeTiming();
+
+    countAllocations = true;
+    frameManager->tf_callback(tree.msg);
+    countAllocations = false;
+
+    _state.PauseTiming();
+    bytes = allocatedBytes - before;
+    frameManager.reset();
+    _state.ResumeTiming();
+  }
+
+  _state.counters["bytes_per_frame"] = static_cast<double>(bytes) / tree.frames.size();
+}
+BENCHMARK(BM_MemoryPerFrame)
+->ArgNames({"frames", "fan_out"})
+->Apply(
+  [](benchmark::internal::Benchmark * _benchmark)
+  {
+    argsProduct(_benchmark, {{100, 1000, 10000}, {1, 8}});
+  })
+->Iterations(3)
+->Unit(benchmark::kMillisecond);
+}  // namespace common
+}  // namespace rviz
+}  // namespace ignition
+
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+
+  rclcpp::shutdown();
+
+  return 0;
+}
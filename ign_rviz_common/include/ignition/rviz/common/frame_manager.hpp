@@ -19,15 +19,25 @@
 
 #include <QObject>
 
+#include <builtin_interfaces/msg/time.hpp>
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 #include <tf2_msgs/msg/tf_message.hpp>
 #include <rclcpp/rclcpp.hpp>
 
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 
@@ -43,7 +53,9 @@ namespace common
 /**
  * @brief Manages and provides information about all the frames
  *
- * Subscribes to TF data to determine the location and orientation of frames
+ * Subscribes to TF data to determine the location and orientation of frames.
+ * Fixed frame poses are computed on the executor thread and published as an
+ * immutable snapshot, so readers on the render thread never wait for tf updates.
  */
 class FrameManager : public QObject
 {
@@ -58,10 +70,41 @@ public:
 
   /**
    * @brief Sets fixed frame for frame tranformations
+   *
+   * Cached poses are re-rooted to the new fixed frame immediately,
+   * without waiting for the next transform message.
+   *
    * @param[in] _fixedFrame: Fixed frame
    */
   void setFixedFrame(const std::string & _fixedFrame);
 
+  /**
+   * @brief Merge an additional tf topic into the frame tree
+   *
+   * Every source has its own subscription and callback group, so sources are
+   * received in parallel on a multi-threaded executor. Frame names of the
+   * source are prefixed, e.g. prefix "robot1/" maps "base_link" to "robot1/base_link".
+   *
+   * @param[in] _topic: Topic publishing tf2_msgs/TFMessage
+   * @param[in] _prefix: Prefix prepended to all frame names of the source
+   * @param[in] _static: True if the topic publishes static transforms
+   * @return False if the topic is already a tf source
+   */
+  bool addTfSource(
+    const std::string & _topic, const std::string & _prefix,
+    bool _static = false);
+
+  /**
+   * @brief Enable or disable pull mode
+   *
+   * In pull mode frame poses are not computed when transforms are received.
+   * They are resolved against the tf buffer when a display requests them,
+   * and memoized until the next render event.
+   *
+   * @param[in] _enabled: True to resolve frames on demand
+   */
+  void setPullMode(bool _enabled);
+
   /**
    * @brief Get frame pose (position and orientation)
    * @param[in] _frame: Frame name
@@ -70,6 +113,44 @@ public:
    */
   bool getFramePose(const std::string & _frame, ignition::math::Pose3d & _pose);
 
+  /**
+   * @brief Get frame pose (position and orientation) at a given time
+   *
+   * The pose is interpolated from the tf buffer history. Recent results are
+   * kept in a bounded LRU cache, so repeated lookups for the same stamp are cheap.
+   * Fails if the buffer can not answer for the stamp, the latest pose is never
+   * substituted for a stamped request.
+   *
+   * @param[in] _frame: Frame name
+   * @param[in] _stamp: Time at which the pose is requested, zero for latest
+   * @param[out] _pose: Frame pose
+   * @return Pose validity (true if pose is valid, else false)
+   */
+  bool getFramePose(
+    const std::string & _frame, const builtin_interfaces::msg::Time & _stamp,
+    ignition::math::Pose3d & _pose);
+
+  /**
+   * @brief Get pose of a frame relative to another frame
+   *
+   * Composed from the cached fixed frame poses of both frames, without
+   * a buffer lookup. Both frames must be connected to the fixed frame.
+   *
+   * @param[in] _target: Frame the pose is expressed in
+   * @param[in] _source: Frame whose pose is requested
+   * @param[out] _pose: Pose of the source frame in the target frame
+   * @return Pose validity (true if pose is valid, else false)
+   */
+  bool getRelativePose(
+    const std::string & _target, const std::string & _source,
+    ignition::math::Pose3d & _pose);
+
+  /**
+   * @brief Set capacity of the stamped frame pose cache
+   * @param[in] _size: Maximum number of (fixed frame, frame, stamp) entries
+   */
+  void setStampedCacheSize(size_t _size);
+
   /**
    * @brief Get parent frame pose (position and orientation)
    * @param[in] _child: Child frame name
@@ -84,12 +165,66 @@ public:
    */
   void getFrames(std::vector<std::string> & _frames);
 
+  /**
+   * @brief Get time at which a frame was last updated by a transform
+   * @param[in] _frame: Frame name
+   * @param[out] _time: Node clock time of the most recent transform involving the frame
+   * @return True if the frame is known
+   */
+  bool getFrameLastUpdate(const std::string & _frame, rclcpp::Time & _time);
+
+  /**
+   * @brief Set expiry of frames that are no longer updated
+   *
+   * Frames not updated within the timeout are evicted from the cache and the
+   * frame list, together with their descendants. Static frames expire with
+   * their parent. Frames with live descendants, and frames connected to their
+   * root only through static transforms, are kept. Evicted frames are not
+   * resolved in pull mode either.
+   *
+   * @param[in] _timeout: Frame timeout, zero to never expire frames
+   */
+  void setFrameTimeout(const std::chrono::nanoseconds & _timeout);
+
+  /**
+   * @brief Get frame list generation
+   *
+   * The generation is incremented every time a new frame is discovered,
+   * so callers can cheaply check whether the frame list has changed.
+   *
+   * @return Frame list generation
+   */
+  uint64_t getFrameListGeneration() const;
+
   /**
    *  @brief Get fixed frame
    *  @return Fixed frame
    */
   std::string getFixedFrame();
 
+  /**
+   * @brief Get frame cache statistics
+   * @param[out] _lookups: Number of buffer lookups performed since construction
+   * @param[out] _savedLookups: Number of buffer lookups avoided by the incremental cache
+   */
+  void getCacheStatistics(uint64_t & _lookups, uint64_t & _savedLookups);
+
+  /**
+   * @brief Get transform batch ingestion statistics
+   * @param[out] _batches: Number of transform messages processed since construction
+   * @param[out] _lastLatency: Processing time of the most recent message
+   * @param[out] _maxLatency: Longest processing time of a single message
+   */
+  void getBatchStatistics(
+    uint64_t & _batches, std::chrono::nanoseconds & _lastLatency,
+    std::chrono::nanoseconds & _maxLatency);
+
+  /**
+   * @brief Qt eventFilters. Original documentation can be found
+   * <a href="https://doc.qt.io/qt-5/qobject.html#eventFilter">here</a>
+   */
+  bool eventFilter(QObject * _object, QEvent * _event) override;
+
 protected:
   /**
    * @brief Callback function to received transform messages
@@ -97,16 +232,412 @@ protected:
    */
   void tf_callback(const tf2_msgs::msg::TFMessage::SharedPtr _msg);
 
+  /**
+   * @brief Callback function to received static transform messages
+   * @param[in] _msg: Static transform message
+   */
+  void tf_static_callback(const tf2_msgs::msg::TFMessage::SharedPtr _msg);
+
+  /**
+   * @brief Callback function to received transform messages of additional tf sources
+   * @param[in] _msg: Transform message
+   * @param[in] _topic: Topic of the source
+   * @param[in] _prefix: Prefix prepended to all frame names of the source
+   * @param[in] _static: True if the source publishes static transforms
+   */
+  void tf_source_callback(
+    const tf2_msgs::msg::TFMessage::SharedPtr _msg, const std::string & _topic,
+    const std::string & _prefix, bool _static);
+
+private:
+  /**
+   * @brief Key of a frame pose at a given time, expressed in a given fixed frame
+   */
+  struct StampedKey
+  {
+    std::string fixedFrame;
+    std::string frame;
+    tf2::TimePoint stamp;
+
+    bool operator==(const StampedKey & _other) const
+    {
+      return this->stamp == _other.stamp && this->frame == _other.frame &&
+             this->fixedFrame == _other.fixedFrame;
+    }
+  };
+
+  /**
+   * @brief Hash function for (fixed frame, frame, stamp) keys
+   */
+  struct StampedKeyHash
+  {
+    size_t operator()(const StampedKey & _key) const
+    {
+      return std::hash<std::string>()(_key.frame) ^
+             (std::hash<std::string>()(_key.fixedFrame) << 1) ^
+             (std::hash<int64_t>()(_key.stamp.time_since_epoch().count()) << 2);
+    }
+  };
+
+  /**
+   * @brief Cached state of a single frame
+   */
+  struct FrameEntry
+  {
+    /// Pose in the fixed frame
+    ignition::math::Pose3d pose;
+
+    /// True once the pose has been computed for the current fixed frame
+    bool resolved = false;
+
+    /// Incremented every time the frame is invalidated
+    uint64_t generation = 0;
+
+    /// Node clock time of the most recent transform involving the frame, in nanoseconds
+    int64_t lastUpdate = 0;
+  };
+
+  /**
+   * @brief Static transform from a frame to its nearest non-static ancestor
+   */
+  struct StaticChain
+  {
+    /// Nearest ancestor that is not connected through a static transform
+    std::string anchor;
+
+    /// Pose of the frame relative to the anchor
+    ignition::math::Pose3d pose;
+  };
+
+  using StaticChainMap = std::unordered_map<std::string, StaticChain>;
+
+  /**
+   * @brief Latest transform from a frame to its parent
+   */
+  struct Edge
+  {
+    /// Parent frame name
+    std::string parent;
+
+    /// Pose of the frame relative to its parent
+    ignition::math::Pose3d pose;
+
+    /// Stamp of the transform
+    tf2::TimePoint stamp;
+  };
+
+  /**
+   * @brief Pose of a frame relative to the root of its tree
+   */
+  struct RootPose
+  {
+    /// Root frame name
+    std::string root;
+
+    /// Pose of the frame relative to the root
+    ignition::math::Pose3d pose;
+  };
+
+  /// Number of shards frame entries are split in
+  static constexpr size_t kFrameShards = 32;
+
+  /// Frame entries indexed by name
+  using FrameShard = std::unordered_map<std::string, FrameEntry>;
+
+  /**
+   * @brief Get shard of a frame
+   * @param[in] _frame: Frame name
+   * @return Shard index
+   */
+  static size_t frameShard(const std::string & _frame)
+  {
+    return std::hash<std::string>()(_frame) % kFrameShards;
+  }
+
+  /**
+   * @brief Fixed frame pose table. Published tables are immutable.
+   *
+   * Shards are shared with the previously published table unless one of
+   * their frames changed, so publishing only copies the modified shards.
+   */
+  struct FrameTable
+  {
+    /// Fixed frame the poses are expressed in
+    std::string fixedFrame;
+
+    /// Stamp of the most recent dynamic transform batch
+    tf2::TimePoint stamp;
+
+    /// Frame entries split by frameShard()
+    std::array<std::shared_ptr<const FrameShard>, kFrameShards> shards;
+
+    /// Composed static chains, shared between tables until a static transform arrives
+    std::shared_ptr<const StaticChainMap> staticChains;
+
+    /**
+     * @brief Find a frame entry
+     * @param[in] _frame: Frame name
+     * @return Frame entry, null if the frame is unknown
+     */
+    const FrameEntry * findFrame(const std::string & _frame) const
+    {
+      const FrameShard & shard = *this->shards[frameShard(_frame)];
+      auto it = shard.find(_frame);
+      return (it != shard.end()) ? &it->second : nullptr;
+    }
+  };
+
+  /**
+   * @brief Mutable frame table of the ingest side, tracks the shards modified since
+   * the last publication
+   */
+  struct WorkingTable
+  {
+    /// Fixed frame the poses are expressed in
+    std::string fixedFrame;
+
+    /// Stamp of the most recent dynamic transform batch
+    tf2::TimePoint stamp;
+
+    /// Frame entries split by frameShard()
+    std::array<FrameShard, kFrameShards> shards;
+
+    /// Shards modified since the last publication
+    std::bitset<kFrameShards> dirtyShards;
+
+    /// Composed static chains, shared between tables until a static transform arrives
+    std::shared_ptr<const StaticChainMap> staticChains;
+
+    /**
+     * @brief Get a frame entry for modification, creating it if needed
+     * @param[in] _frame: Frame name
+     * @return Frame entry
+     */
+    FrameEntry & frame(const std::string & _frame)
+    {
+      const size_t shard = frameShard(_frame);
+      this->dirtyShards.set(shard);
+      return this->shards[shard][_frame];
+    }
+
+    /**
+     * @brief Check if a frame is known
+     * @param[in] _frame: Frame name
+     * @return True if the frame has an entry
+     */
+    bool hasFrame(const std::string & _frame) const
+    {
+      return this->shards[frameShard(_frame)].count(_frame) > 0;
+    }
+
+    /**
+     * @brief Get number of frames
+     * @return Frame count
+     */
+    size_t frameCount() const
+    {
+      size_t count = 0;
+      for (const auto & shard : this->shards) {
+        count += shard.size();
+      }
+      return count;
+    }
+  };
+
+  /**
+   * @brief Update the tf tree cache with received transforms. Caller must hold tf_mutex_.
+   * @param[in] _msg: Transform message
+   * @param[in] _static: True if transforms were received on /tf_static
+   */
+  void processTransforms(const tf2_msgs::msg::TFMessage & _msg, bool _static);
+
+  /**
+   * @brief Forget all dynamic transforms after time jumped backwards, static
+   * transforms are kept. Caller must hold tf_mutex_.
+   */
+  void resetDynamicFrames();
+
+  /**
+   * @brief Clock jump callback, resets dynamic frames when time jumps backwards
+   * @param[in] _jump: Time jump information
+   */
+  void onTimeJump(const rcl_time_jump_t & _jump);
+
+  /**
+   * @brief Invalidate the stamped frame pose cache. Does not block, the cache is
+   * cleared by the next stamped lookup on the render side.
+   */
+  void invalidateStampedCache();
+
+  /**
+   * @brief Clear the stamped frame pose cache if it was invalidated.
+   * Caller must hold render_mutex_.
+   */
+  void syncStampedCache();
+
+  /**
+   * @brief Compose static edges into chains anchored at the nearest dynamic ancestor
+   */
+  void rebuildStaticChains();
+
+  /**
+   * @brief Update fixed frame poses of the updated frames and their descendants
+   * in a single top-down pass. Caller must hold tf_mutex_.
+   * @param[in] _updatedFrames: Child frames of the received transforms
+   */
+  void updateFramePoses(const std::vector<std::string> & _updatedFrames);
+
+  /**
+   * @brief Express cached root relative poses in the current fixed frame.
+   * Caller must hold tf_mutex_.
+   * @param[in] _frames: Frames to update
+   */
+  void applyFixedFrame(const std::vector<std::string> & _frames);
+
+  /**
+   * @brief Get number of ancestors of a frame
+   * @param[in] _frame: Frame name
+   * @return Depth of the frame in its tree
+   */
+  size_t frameDepth(const std::string & _frame) const;
+
+  /**
+   * @brief Record a parent-child edge of the tf tree
+   * @param[in] _transform: Transform from parent to child frame
+   * @param[in] _stamp: Stamp of the transform
+   */
+  void updateEdge(
+    const geometry_msgs::msg::TransformStamped & _transform,
+    const tf2::TimePoint & _stamp);
+
+  /**
+   * @brief Mark a frame and all its descendants as dirty
+   * @param[in] _frame: Root of the subtree to invalidate
+   */
+  void invalidateSubtree(const std::string & _frame);
+
+  /**
+   * @brief Check if a frame is the fixed frame or one of its ancestors
+   * @param[in] _frame: Frame name
+   * @return True if moving the frame moves the fixed frame
+   */
+  bool isFixedFrameAncestor(const std::string & _frame) const;
+
+  /**
+   * @brief Evict frames that have not been updated within the frame timeout
+   */
+  void evictStaleFrames();
+
+  /**
+   * @brief Invalidate published pose of a frame
+   * @param[in] _frame: Frame name
+   */
+  void markDirty(const std::string & _frame);
+
+  /**
+   * @brief Look up fixed frame pose of a frame in the tf buffer
+   * @param[in] _fixedFrame: Fixed frame
+   * @param[in] _frame: Frame name
+   * @param[in] _time: Time of the lookup
+   * @param[out] _pose: Frame pose
+   * @return True if lookup succeeded
+   */
+  bool lookupFramePose(
+    const std::string & _fixedFrame, const std::string & _frame,
+    const tf2::TimePoint & _time, ignition::math::Pose3d & _pose);
+
+  /**
+   * @brief Publish the working pose table to readers. Caller must hold tf_mutex_.
+   */
+  void publishTable();
+
+  /**
+   * @brief Get fixed frame pose of a frame from a pose table
+   * @param[in] _snapshot: Pose table to read from
+   * @param[in] _frame: Frame name
+   * @param[out] _pose: Frame pose
+   * @return Pose validity (true if pose is valid, else false)
+   */
+  bool snapshotFramePose(
+    const std::shared_ptr<const FrameTable> & _snapshot, const std::string & _frame,
+    ignition::math::Pose3d & _pose);
+
+  /**
+   * @brief Resolve a frame pose on demand in pull mode. Caller must hold render_mutex_.
+   * @param[in] _snapshot: Pose table to resolve against
+   * @param[in] _frame: Frame name
+   * @param[out] _pose: Frame pose
+   * @return Pose validity (true if pose is valid, else false)
+   */
+  bool pullFramePose(
+    const std::shared_ptr<const FrameTable> & _snapshot, const std::string & _frame,
+    ignition::math::Pose3d & _pose);
+
 private:
   rclcpp::Node::SharedPtr node;
-  std::mutex tf_mutex_;
-  std::string fixedFrame;
   std::shared_ptr<tf2_ros::Buffer> tfBuffer;
   std::shared_ptr<tf2_ros::TransformListener> tfListener;
   rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr subscriber;
-  std::unordered_map<std::string, ignition::math::Pose3d> tfTree;
-  tf2::TimePoint timePoint;
-  unsigned int frameCount;
+  rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr staticSubscriber;
+  rclcpp::TimerBase::SharedPtr expiryTimer;
+  rclcpp::JumpHandler::SharedPtr timeJumpHandler;
+
+  // Subscriptions of all tf sources indexed by topic, guarded by sources_mutex_
+  std::mutex sources_mutex_;
+  std::unordered_map<std::string, rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr>
+  sources;
+
+  // Ingest state, owned by the executor thread and guarded by tf_mutex_
+  std::mutex tf_mutex_;
+  WorkingTable workingTable;
+  std::unordered_map<std::string, Edge> edges;
+  std::unordered_map<std::string, std::unordered_set<std::string>> childFrames;
+  std::unordered_map<std::string, RootPose> rootPoses;
+  bool fullRecompute;
+
+  // Frame timeout in nanoseconds, zero if frames never expire
+  std::atomic<int64_t> frameTimeout;
+
+  // Static transforms (child -> parent and pose relative to parent)
+  std::unordered_map<std::string, std::pair<std::string, ignition::math::Pose3d>> staticEdges;
+
+  // Frame set and fixed frame versions, and the versions last delivered to the UI thread
+  std::atomic<uint64_t> frameListGeneration;
+  std::atomic<uint64_t> fixedFrameGeneration;
+  uint64_t deliveredFrameListGeneration;
+  uint64_t deliveredFixedFrameGeneration;
+
+  // Latest published table. Accessed only through std::atomic_load / std::atomic_store.
+  std::shared_ptr<const FrameTable> table;
+
+  // Render side state, guarded by render_mutex_ which the executor never takes
+  std::mutex render_mutex_;
+  std::atomic<bool> pullMode;
+  std::string pulledFixedFrame;
+  std::unordered_map<std::string, std::pair<uint64_t, ignition::math::Pose3d>> pulledPoses;
+  std::atomic<bool> pulledPosesStale;
+  std::unordered_map<StampedKey, ignition::math::Pose3d, StampedKeyHash> tickCache;
+
+  // Bounded LRU of stamped frame poses, most recently used first
+  using StampedPose = std::pair<StampedKey, ignition::math::Pose3d>;
+  std::list<StampedPose> stampedCache;
+  std::unordered_map<StampedKey, std::list<StampedPose>::iterator, StampedKeyHash>
+  stampedCacheIndex;
+  size_t stampedCacheSize;
+
+  // Bumped by the executor to invalidate the stamped cache, and the last
+  // version the render side cleared the cache for
+  std::atomic<uint64_t> stampedCacheGeneration;
+  uint64_t clearedStampedCacheGeneration;
+
+  // Cache statistics
+  std::atomic<uint64_t> lookupCount;
+  std::atomic<uint64_t> savedLookupCount;
+
+  // Batch ingestion statistics, latencies in nanoseconds
+  std::atomic<uint64_t> batchCount;
+  std::atomic<int64_t> lastBatchLatency;
+  std::atomic<int64_t> maxBatchLatency;
 };
 }  // namespace common
 }  // namespace rviz
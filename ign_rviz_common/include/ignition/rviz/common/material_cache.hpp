@@ -0,0 +1,105 @@
+// Copyright (c) 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IGNITION__RVIZ__COMMON__MATERIAL_CACHE_HPP_
+#define IGNITION__RVIZ__COMMON__MATERIAL_CACHE_HPP_
+
+#include <ignition/rendering.hh>
+
+#include <std_msgs/msg/color_rgba.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace ignition
+{
+namespace rviz
+{
+namespace common
+{
+/**
+ * @brief Reference counted materials indexed by color
+ *
+ * Colors are quantized to 8 bits per channel, so markers of nearly equal
+ * colors share a single material. A material is destroyed once the last
+ * marker using it releases it.
+ */
+class MaterialCache
+{
+public:
+  /**
+   * @brief Get the cache shared by all marker managers of a scene. Lives in this library,
+   * so that displays loaded as separate plugin libraries share one instance.
+   * @param[in] _scene Scene materials are created in
+   * @return Material cache, created on first use and destroyed with its last user
+   */
+  static std::shared_ptr<MaterialCache> instance(rendering::ScenePtr _scene);
+
+  /**
+   * @brief Constructor
+   * @param[in] _scene Scene materials are created in
+   */
+  explicit MaterialCache(rendering::ScenePtr _scene);
+
+  /**
+   * @brief Destroy all remaining materials
+   */
+  ~MaterialCache();
+
+  MaterialCache(const MaterialCache &) = delete;
+  MaterialCache & operator=(const MaterialCache &) = delete;
+
+  /**
+   * @brief Get material of a color, creating it if needed. Must be released with release().
+   * @param[in] _color Color message
+   * @return Shared material, must not be modified
+   */
+  rendering::MaterialPtr acquire(const std_msgs::msg::ColorRGBA & _color);
+
+  /**
+   * @brief Release a material returned by acquire()
+   * @param[in] _material Material, ignored if null
+   */
+  void release(const rendering::MaterialPtr & _material);
+
+  /**
+   * @brief Get number of materials alive
+   * @return Material count
+   */
+  std::size_t size() const;
+
+private:
+  struct CacheEntry
+  {
+    rendering::MaterialPtr material;
+    unsigned int references;
+  };
+
+  rendering::ScenePtr scene;
+
+  mutable std::mutex mutex;
+
+  /// Quantized RGBA color to material
+  std::unordered_map<uint32_t, CacheEntry> materials;
+
+  /// Material to quantized RGBA color, used on release
+  std::unordered_map<const rendering::Material *, uint32_t> colors;
+};
+}  // namespace common
+}  // namespace rviz
+}  // namespace ignition
+
+#endif  // IGNITION__RVIZ__COMMON__MATERIAL_CACHE_HPP_
@@ -0,0 +1,125 @@
+// Copyright (c) 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IGNITION__RVIZ__COMMON__RENDER_BUDGET_HPP_
+#define IGNITION__RVIZ__COMMON__RENDER_BUDGET_HPP_
+
+#include <QObject>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace ignition
+{
+namespace rviz
+{
+namespace common
+{
+/**
+ * @brief Time budget shared by all display updates of a render frame
+ *
+ * Displays acquire the budget before updating and release it with the time
+ * spent. Once the budget of a frame is used up, low and normal priority
+ * displays are skipped until the next frame, high priority displays always
+ * update. A display is never skipped more than kMaxSkippedFrames frames in a row.
+ *
+ * The budget is reset on every render event. It must be installed as event
+ * filter before the displays, so it is notified after them.
+ */
+class RenderBudget : public QObject
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Display update priority
+   */
+  enum class Priority
+  {
+    /// Skipped once half of the budget is used
+    Low,
+    /// Skipped once the budget is used
+    Normal,
+    /// Never skipped
+    High
+  };
+
+  /// Maximum number of consecutive frames a display can be skipped
+  static constexpr unsigned int kMaxSkippedFrames = 30;
+
+  /**
+   * @brief Constructor
+   * @param[in] _budget: Time available for display updates per frame
+   */
+  explicit RenderBudget(const std::chrono::nanoseconds & _budget);
+
+  /**
+   * @brief Set time available for display updates per frame
+   * @param[in] _budget: Budget, zero to never skip updates
+   */
+  void setBudget(const std::chrono::nanoseconds & _budget);
+
+  /**
+   * @brief Get time available for display updates per frame
+   * @return Budget
+   */
+  std::chrono::nanoseconds getBudget() const;
+
+  /**
+   * @brief Check if a display can update in the current frame. Called on the render thread.
+   * @param[in] _priority: Display priority
+   * @param[in] _skippedFrames: Number of consecutive frames the display was skipped
+   * @return True if the display should update, false to skip it
+   */
+  bool acquire(Priority _priority, unsigned int _skippedFrames);
+
+  /**
+   * @brief Account for time spent updating a display. Called on the render thread.
+   * @param[in] _elapsed: Update duration
+   */
+  void release(const std::chrono::nanoseconds & _elapsed);
+
+  /**
+   * @brief Get time spent updating displays in the last completed frame
+   * @return Update time
+   */
+  std::chrono::nanoseconds getLastFrameTime() const;
+
+  /**
+   * @brief Get number of skipped display updates
+   * @return Updates skipped since construction
+   */
+  uint64_t getSkippedUpdates() const;
+
+  /**
+   * @brief Qt eventFilters. Original documentation can be found
+   * <a href="https://doc.qt.io/qt-5/qobject.html#eventFilter">here</a>
+   */
+  bool eventFilter(QObject * _object, QEvent * _event) override;
+
+private:
+  std::atomic<int64_t> budget;
+  std::atomic<int64_t> lastFrameTime;
+  std::atomic<uint64_t> skippedUpdates;
+
+  // Time spent in the current frame, owned by the render thread
+  int64_t spent;
+};
+
+}  // namespace common
+}  // namespace rviz
+}  // namespace ignition
+
+#endif  // IGNITION__RVIZ__COMMON__RENDER_BUDGET_HPP_
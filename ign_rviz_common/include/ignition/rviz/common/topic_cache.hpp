@@ -0,0 +1,106 @@
+// Copyright (c) 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IGNITION__RVIZ__COMMON__TOPIC_CACHE_HPP_
+#define IGNITION__RVIZ__COMMON__TOPIC_CACHE_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ignition
+{
+namespace rviz
+{
+namespace common
+{
+/**
+ * @brief Topics of the ROS graph indexed by message type
+ *
+ * The graph is queried on a background thread whenever the node reports a
+ * graph change, and published as an immutable snapshot. Lookups never query
+ * the graph and only copy the matching topics.
+ */
+class TopicCache
+{
+public:
+  /**
+   * @brief Constructor. Queries the graph once and starts the background thread.
+   * @param[in] _node: ROS Node shared pointer
+   * @throws anything rclcpp::exceptions::throw_from_rcl_error can throw.
+   */
+  explicit TopicCache(rclcpp::Node::SharedPtr _node);
+
+  /**
+   * @brief Stop the background thread
+   */
+  ~TopicCache();
+
+  TopicCache(const TopicCache &) = delete;
+  TopicCache & operator=(const TopicCache &) = delete;
+
+  /**
+   * @brief Get topics publishing or subscribed with a message type
+   * @param[in] _type: Message type, e.g. "sensor_msgs/msg/LaserScan"
+   * @return Topic names in alphabetical order
+   */
+  std::vector<std::string> getTopics(const std::string & _type) const;
+
+  /**
+   * @brief Get number of graph updates, changes whenever the topic list changes
+   * @return Graph generation
+   */
+  uint64_t getGeneration() const;
+
+  /**
+   * @brief Query the graph now, without waiting for a graph event
+   * @throws anything rclcpp::exceptions::throw_from_rcl_error can throw.
+   */
+  void refresh();
+
+private:
+  /**
+   * @brief Background thread loop, refreshes the cache on graph events
+   */
+  void run();
+
+private:
+  /// Message type to topic names
+  using TopicIndex = std::unordered_map<std::string, std::vector<std::string>>;
+
+  rclcpp::Node::SharedPtr node;
+
+  // Accessed only through std::atomic_load and std::atomic_store
+  std::shared_ptr<const TopicIndex> index;
+
+  // Serializes graph queries, so an older query never replaces a newer one
+  std::mutex refreshMutex;
+
+  std::atomic<uint64_t> generation;
+  std::atomic<bool> running;
+  std::thread thread;
+};
+
+}  // namespace common
+}  // namespace rviz
+}  // namespace ignition
+
+#endif  // IGNITION__RVIZ__COMMON__TOPIC_CACHE_HPP_
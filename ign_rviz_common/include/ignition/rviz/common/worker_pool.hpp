@@ -0,0 +1,86 @@
+// Copyright (c) 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IGNITION__RVIZ__COMMON__WORKER_POOL_HPP_
+#define IGNITION__RVIZ__COMMON__WORKER_POOL_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ignition
+{
+namespace rviz
+{
+namespace common
+{
+/**
+ * @brief Fixed size pool of threads running tasks in submission order
+ *
+ * Used by displays to convert messages into render-ready data away from
+ * both the ROS executor and the render thread.
+ */
+class WorkerPool
+{
+public:
+  /**
+   * @brief Start worker threads
+   * @param[in] _threads: Number of threads, zero to use one less than the
+   * number of hardware threads
+   */
+  explicit WorkerPool(unsigned int _threads = 0);
+
+  /**
+   * @brief Discard pending tasks and join worker threads.
+   * Tasks already running are completed.
+   */
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  /**
+   * @brief Queue a task
+   * @param[in] _task: Task to run on one of the worker threads
+   */
+  void post(std::function<void()> _task);
+
+  /**
+   * @brief Get number of worker threads
+   * @return Number of worker threads
+   */
+  unsigned int threadCount() const;
+
+private:
+  /**
+   * @brief Worker thread loop
+   */
+  void run();
+
+private:
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<std::function<void()>> tasks;
+  std::vector<std::thread> threads;
+  bool stopping;
+};
+
+}  // namespace common
+}  // namespace rviz
+}  // namespace ignition
+
+#endif  // IGNITION__RVIZ__COMMON__WORKER_POOL_HPP_
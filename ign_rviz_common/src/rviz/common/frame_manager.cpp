@@ -12,9 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <ignition/gui/Application.hh>
-#include <ignition/gui/MainWindow.hh>
+#include <ignition/gui/GuiEvents.hh>
 
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iterator>
 #include <string>
 #include <utility>
 #include <memory>
@@ -29,140 +34,1142 @@ namespace rviz
 {
 namespace common
 {
+constexpr size_t FrameManager::kFrameShards;
+
+namespace
+{
+////////////////////////////////////////////////////////////////////////////////
+math::Pose3d transformToPose(const geometry_msgs::msg::Transform & _transform)
+{
+  return math::Pose3d(
+    _transform.translation.x,
+    _transform.translation.y,
+    _transform.translation.z,
+    _transform.rotation.w,
+    _transform.rotation.x,
+    _transform.rotation.y,
+    _transform.rotation.z);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Compose a child pose expressed in a parent frame with the parent pose,
+ * giving the child pose in the parent's reference frame.
+ */
+math::Pose3d composePose(const math::Pose3d & _parent, const math::Pose3d & _child)
+{
+  return math::Pose3d(
+    _parent.Pos() + _parent.Rot().RotateVector(_child.Pos()),
+    _parent.Rot() * _child.Rot());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+tf2::TimePoint stampToTimePoint(const builtin_interfaces::msg::Time & _stamp)
+{
+  return tf2::TimePoint(
+    std::chrono::seconds(_stamp.sec) +
+    std::chrono::nanoseconds(_stamp.nanosec));
+}
+
+/// Transforms older than the applied transform of their edge by more than this are ignored
+constexpr std::chrono::seconds kStaleTransformAge(1);
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
 /**
  * Stores reference to ROS Node
  * Creates a tfBuffer and tfListener.
  * Creates a tf subscription and binds callback to it.
  */
 FrameManager::FrameManager(rclcpp::Node::SharedPtr _node)
-: QObject(), frameCount(0)
+: QObject(), fullRecompute(false), frameTimeout(0), frameListGeneration(0),
+  fixedFrameGeneration(0),
+  deliveredFrameListGeneration(0), deliveredFixedFrameGeneration(0), pullMode(false),
+  pulledPosesStale(false), stampedCacheSize(256), stampedCacheGeneration(0),
+  clearedStampedCacheGeneration(0), lookupCount(0), savedLookupCount(0),
+  batchCount(0), lastBatchLatency(0), maxBatchLatency(0)
 {
   this->node = std::move(_node);
 
   tfBuffer = std::make_shared<tf2_ros::Buffer>(this->node->get_clock());
   tfListener = std::make_shared<tf2_ros::TransformListener>(*tfBuffer);
 
+  this->workingTable.staticChains = std::make_shared<const StaticChainMap>();
+  this->publishTable();
+
+  // Each tf source has its own callback group, so sources are processed in parallel
+  rclcpp::SubscriptionOptions options;
+  options.callback_group = this->node->create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive);
+
   this->subscriber = this->node->create_subscription<tf2_msgs::msg::TFMessage>(
     "/tf", 10,
-    std::bind(&FrameManager::tf_callback, this, std::placeholders::_1));
+    std::bind(&FrameManager::tf_callback, this, std::placeholders::_1),
+    options);
+
+  options.callback_group = this->node->create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive);
+
+  // Intra-process communication does not support transient local durability
+  options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+
+  // Static transforms are latched by their publishers
+  this->staticSubscriber = this->node->create_subscription<tf2_msgs::msg::TFMessage>(
+    "/tf_static", rclcpp::QoS(100).transient_local(),
+    std::bind(&FrameManager::tf_static_callback, this, std::placeholders::_1),
+    options);
+
+  this->expiryTimer = this->node->create_wall_timer(
+    std::chrono::seconds(1),
+    std::bind(&FrameManager::evictStaleFrames, this));
+
+  // Sim time resets and /clock restarts, the tf buffer clears itself on the same event
+  rcl_jump_threshold_t threshold;
+  threshold.on_clock_change = true;
+  threshold.min_forward.nanoseconds = 0;
+  threshold.min_backward.nanoseconds = -1;
+  this->timeJumpHandler = this->node->get_clock()->create_jump_callback(
+    nullptr, std::bind(&FrameManager::onTimeJump, this, std::placeholders::_1), threshold);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void FrameManager::setFixedFrame(const std::string & _fixedFrame)
 {
-  std::lock_guard<std::mutex>(this->tf_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(this->tf_mutex_);
+
+    this->workingTable.fixedFrame = _fixedFrame;
 
-  this->tfTree.clear();
-  this->fixedFrame = _fixedFrame;
+    // Every cached pose is relative to the old fixed frame
+    for (auto & shard : this->workingTable.shards) {
+      for (auto & frame : shard) {
+        frame.second.resolved = false;
+        frame.second.generation++;
+      }
+    }
+    this->workingTable.dirtyShards.set();
 
-  // Send fixed frame changed event
-  if (ignition::gui::App()) {
-    ignition::gui::App()->sendEvent(
-      ignition::gui::App()->findChild<ignition::gui::MainWindow *>(),
-      new events::FixedFrameChanged());
+    if (!this->pullMode) {
+      if (this->fullRecompute) {
+        this->updateFramePoses({});
+      } else {
+        // Re-root cached poses, displays keep their frames without waiting for tf
+        std::vector<std::string> frames;
+        frames.reserve(this->rootPoses.size());
+        for (const auto & frame : this->rootPoses) {
+          frames.push_back(frame.first);
+        }
+        this->applyFixedFrame(frames);
+      }
+    }
+
+    this->publishTable();
   }
+
+  this->invalidateStampedCache();
+
+  // Fixed frame changed event is delivered on the next render event
+  this->fixedFrameGeneration++;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::string FrameManager::getFixedFrame()
 {
-  std::lock_guard<std::mutex>(this->tf_mutex_);
-  return this->fixedFrame;
+  return std::atomic_load(&this->table)->fixedFrame;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FrameManager::addTfSource(
+  const std::string & _topic, const std::string & _prefix,
+  bool _static)
+{
+  std::lock_guard<std::mutex> lock(this->sources_mutex_);
+
+  if (_topic == "/tf" || _topic == "/tf_static" || this->sources.count(_topic) > 0) {
+    return false;
+  }
+
+  rclcpp::SubscriptionOptions options;
+  options.callback_group = this->node->create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive);
+
+  const rclcpp::QoS qos = _static ? rclcpp::QoS(100).transient_local() : rclcpp::QoS(10);
+  if (_static) {
+    options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  }
+
+  this->sources[_topic] = this->node->create_subscription<tf2_msgs::msg::TFMessage>(
+    _topic, qos,
+    std::bind(
+      &FrameManager::tf_source_callback, this, std::placeholders::_1,
+      _topic, _prefix, _static),
+    options);
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::setPullMode(bool _enabled)
+{
+  {
+    // Root relative poses are not maintained in pull mode
+    std::lock_guard<std::mutex> lock(this->tf_mutex_);
+    this->fullRecompute = true;
+  }
+
+  std::lock_guard<std::mutex> lock(this->render_mutex_);
+  this->pullMode = _enabled;
+  this->tickCache.clear();
+  this->pulledPoses.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Start a new memoization window on every ign::gui render event, and post
+ * coalesced frame events so handlers run at most once per UI tick.
+ */
+bool FrameManager::eventFilter(QObject * _object, QEvent * _event)
+{
+  if (_event->type() == gui::events::Render::kType) {
+    {
+      std::lock_guard<std::mutex> lock(this->render_mutex_);
+      this->tickCache.clear();
+
+      if (this->pulledPosesStale.exchange(false)) {
+        const std::shared_ptr<const FrameTable> snapshot = std::atomic_load(&this->table);
+        for (auto it = this->pulledPoses.begin(); it != this->pulledPoses.end(); ) {
+          it = (snapshot->findFrame(it->first) == nullptr) ? this->pulledPoses.erase(it) :
+            std::next(it);
+        }
+      }
+    }
+
+    const uint64_t fixedFrameGen = this->fixedFrameGeneration;
+    if (fixedFrameGen != this->deliveredFixedFrameGeneration) {
+      this->deliveredFixedFrameGeneration = fixedFrameGen;
+      QCoreApplication::postEvent(_object, new events::FixedFrameChanged());
+    }
+
+    const uint64_t frameListGen = this->frameListGeneration;
+    if (frameListGen != this->deliveredFrameListGeneration) {
+      this->deliveredFrameListGeneration = frameListGen;
+      QCoreApplication::postEvent(_object, new events::FrameListChanged());
+    }
+  }
+
+  return QObject::eventFilter(_object, _event);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FrameManager::getFrameLastUpdate(const std::string & _frame, rclcpp::Time & _time)
+{
+  const std::shared_ptr<const FrameTable> snapshot = std::atomic_load(&this->table);
+
+  const FrameEntry * entry = snapshot->findFrame(_frame);
+  if (entry == nullptr) {
+    return false;
+  }
+
+  _time = rclcpp::Time(entry->lastUpdate, this->node->get_clock()->get_clock_type());
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::setFrameTimeout(const std::chrono::nanoseconds & _timeout)
+{
+  this->frameTimeout = _timeout.count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+uint64_t FrameManager::getFrameListGeneration() const
+{
+  return this->frameListGeneration;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::getCacheStatistics(uint64_t & _lookups, uint64_t & _savedLookups)
+{
+  _lookups = this->lookupCount;
+  _savedLookups = this->savedLookupCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::getBatchStatistics(
+  uint64_t & _batches, std::chrono::nanoseconds & _lastLatency,
+  std::chrono::nanoseconds & _maxLatency)
+{
+  _batches = this->batchCount;
+  _lastLatency = std::chrono::nanoseconds(this->lastBatchLatency.load());
+  _maxLatency = std::chrono::nanoseconds(this->maxBatchLatency.load());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void FrameManager::getFrames(std::vector<std::string> & _frames)
 {
-  tfBuffer->_getFrameStrings(_frames);
+  const std::shared_ptr<const FrameTable> snapshot = std::atomic_load(&this->table);
+
+  _frames.clear();
+  for (const auto & shard : snapshot->shards) {
+    for (const auto & frame : *shard) {
+      _frames.push_back(frame.first);
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void FrameManager::tf_callback(const tf2_msgs::msg::TFMessage::SharedPtr _msg)
 {
-  std::lock_guard<std::mutex>(this->tf_mutex_);
+  std::lock_guard<std::mutex> lock(this->tf_mutex_);
+  this->processTransforms(*_msg, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::tf_static_callback(const tf2_msgs::msg::TFMessage::SharedPtr _msg)
+{
+  std::lock_guard<std::mutex> lock(this->tf_mutex_);
+  this->processTransforms(*_msg, true);
+}
 
-  if (this->fixedFrame.empty()) {
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Prefixes frame names and feeds the tf buffer before taking tf_mutex_, so
+ * only the tree update is serialized between sources.
+ */
+void FrameManager::tf_source_callback(
+  const tf2_msgs::msg::TFMessage::SharedPtr _msg, const std::string & _topic,
+  const std::string & _prefix, bool _static)
+{
+  if (!_prefix.empty()) {
+    for (auto & transform : _msg->transforms) {
+      transform.header.frame_id = _prefix + transform.header.frame_id;
+      transform.child_frame_id = _prefix + transform.child_frame_id;
+    }
+  }
+
+  // The tf listener only fills the buffer from /tf and /tf_static
+  const std::string authority = "ign_rviz " + _topic;
+  for (const auto & transform : _msg->transforms) {
+    try {
+      this->tfBuffer->setTransform(transform, authority, _static);
+    } catch (tf2::TransformException & e) {
+      RCLCPP_WARN(this->node->get_logger(), e.what());
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->tf_mutex_);
+  this->processTransforms(*_msg, _static);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Applies the newest transform of every edge in the message, then updates the
+ * fixed frame poses of all affected frames in a single top-down pass.
+ */
+void FrameManager::processTransforms(const tf2_msgs::msg::TFMessage & _msg, bool _static)
+{
+  if (this->workingTable.fixedFrame.empty()) {
     RCLCPP_ERROR(this->node->get_logger(), "No frame id specified");
     return;
   }
 
-  std::vector<std::string> frame_ids;
-  tfBuffer->_getFrameStrings(frame_ids);
+  if (_msg.transforms.empty()) {
+    return;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const int64_t now = this->node->now().nanoseconds();
+
+  // Only the newest transform of each edge in the batch is applied. Slightly
+  // older transforms of later batches are applied, backward time jumps are
+  // handled by onTimeJump.
+  std::unordered_map<std::string, size_t> newest;
+  for (size_t i = 0; i < _msg.transforms.size(); ++i) {
+    const auto & transform = _msg.transforms[i];
+    const tf2::TimePoint stamp = stampToTimePoint(transform.header.stamp);
+
+    auto it = newest.emplace(transform.child_frame_id, i).first;
+    if (stamp >= stampToTimePoint(_msg.transforms[it->second].header.stamp)) {
+      it->second = i;
+    }
+  }
+
+  bool fixedFrameMoved = false;
+  bool staticEdgesChanged = false;
+  tf2::TimePoint batchStamp = tf2::TimePointZero;
+  std::vector<std::string> updatedFrames;
+  updatedFrames.reserve(newest.size());
 
-  if (frame_ids.size() != this->frameCount) {
-    // Send frame list changed event
-    if (ignition::gui::App()) {
-      ignition::gui::App()->sendEvent(
-        ignition::gui::App()->findChild<ignition::gui::MainWindow *>(),
-        new events::FrameListChanged());
+  for (size_t i = 0; i < _msg.transforms.size(); ++i) {
+    const auto & transform = _msg.transforms[i];
+    if (newest[transform.child_frame_id] != i) {
+      continue;
     }
 
-    this->frameCount = frame_ids.size();
+    const tf2::TimePoint stamp = stampToTimePoint(transform.header.stamp);
+
+    // A late publisher, or a second one of the same frame, must not move the edge back
+    auto edge = this->edges.find(transform.child_frame_id);
+    if (!_static && edge != this->edges.end() && edge->second.stamp - stamp > kStaleTransformAge) {
+      RCLCPP_DEBUG(
+        this->node->get_logger(), "Ignoring stale transform of frame %s",
+        transform.child_frame_id.c_str());
+      continue;
+    }
+    batchStamp = std::max(batchStamp, stamp);
+
+    this->updateEdge(transform, stamp);
+    this->workingTable.frame(transform.header.frame_id).lastUpdate = now;
+    this->workingTable.frame(transform.child_frame_id).lastUpdate = now;
+    fixedFrameMoved |= this->isFixedFrameAncestor(transform.child_frame_id);
+    updatedFrames.push_back(transform.child_frame_id);
+
+    if (_static) {
+      this->staticEdges[transform.child_frame_id] =
+        std::make_pair(transform.header.frame_id, transformToPose(transform.transform));
+      staticEdgesChanged = true;
+    } else if (this->staticEdges.erase(transform.child_frame_id) > 0) {
+      // Frame previously published as static is now dynamic
+      staticEdgesChanged = true;
+    }
   }
 
-  builtin_interfaces::msg::Time timeStamp = _msg->transforms[0].header.stamp;
-  timePoint =
-    tf2::TimePoint(
-    std::chrono::seconds(timeStamp.sec) +
-    std::chrono::nanoseconds(timeStamp.nanosec));
+  // Static transforms are valid at all times and do not change the stamp
+  if (!_static && !updatedFrames.empty()) {
+    this->workingTable.stamp = batchStamp;
+  }
 
-  for (const auto frame : frame_ids) {
-    try {
-      /*
-       * TODO(Sarathkrishnan Ramesh): Reducing the tiemout for lookupTransform affects
-       * smoothness of tf visualization.
-       */
-      geometry_msgs::msg::TransformStamped tf = tfBuffer->lookupTransform(
-        fixedFrame, timePoint,
-        frame, timePoint,
-        fixedFrame, tf2::Duration(5000));
-
-      tfTree[tf.child_frame_id] = ignition::math::Pose3d(
-        tf.transform.translation.x,
-        tf.transform.translation.y,
-        tf.transform.translation.z,
-        tf.transform.rotation.w,
-        tf.transform.rotation.x,
-        tf.transform.rotation.y,
-        tf.transform.rotation.z);
-    } catch (tf2::LookupException & e) {
-      RCLCPP_WARN(this->node->get_logger(), e.what());
-    } catch (tf2::ConnectivityException & e) {
-      RCLCPP_WARN(this->node->get_logger(), e.what());
-    } catch (tf2::ExtrapolationException & e) {
-      RCLCPP_WARN(this->node->get_logger(), e.what());
-    } catch (tf2::InvalidArgumentException & e) {
-      RCLCPP_WARN(this->node->get_logger(), e.what());
+  if (staticEdgesChanged) {
+    this->rebuildStaticChains();
+  }
+
+  if (this->pullMode) {
+    // Dirty frames are resolved when a display requests them
+    if (fixedFrameMoved) {
+      for (auto & shard : this->workingTable.shards) {
+        for (auto & frame : shard) {
+          frame.second.generation++;
+        }
+      }
+      this->workingTable.dirtyShards.set();
+    } else {
+      for (const auto & frame : updatedFrames) {
+        this->invalidateSubtree(frame);
+      }
+    }
+  } else {
+    this->updateFramePoses(updatedFrames);
+  }
+
+  this->publishTable();
+
+  const int64_t latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start).count();
+  this->batchCount++;
+  this->lastBatchLatency = latency;
+  if (latency > this->maxBatchLatency) {
+    this->maxBatchLatency = latency;
+  }
+
+  RCLCPP_DEBUG(
+    this->node->get_logger(), "Processed %zu transforms in %ld ns",
+    _msg.transforms.size(), static_cast<long>(latency));  // NOLINT
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::updateFramePoses(const std::vector<std::string> & _updatedFrames)
+{
+  std::vector<std::string> roots;
+
+  if (this->fullRecompute) {
+    // Start from the roots of every tree
+    for (const auto & shard : this->workingTable.shards) {
+      for (const auto & frame : shard) {
+        if (this->edges.find(frame.first) == this->edges.end()) {
+          roots.push_back(frame.first);
+        }
+      }
+    }
+    this->fullRecompute = false;
+  } else {
+    roots = _updatedFrames;
+  }
+
+  // Sort subtree roots by depth, so that parents are always updated before children
+  std::vector<std::pair<size_t, std::string>> sortedRoots;
+  sortedRoots.reserve(roots.size());
+  for (auto & root : roots) {
+    sortedRoots.emplace_back(this->frameDepth(root), std::move(root));
+  }
+  std::sort(sortedRoots.begin(), sortedRoots.end());
+
+  // Single top-down pass updating root relative poses of all affected frames
+  std::unordered_set<std::string> visited;
+  std::vector<std::string> updated;
+  std::vector<std::string> queue;
+
+  for (const auto & root : sortedRoots) {
+    queue.clear();
+    queue.push_back(root.second);
+
+    for (size_t i = 0; i < queue.size(); ++i) {
+      const std::string frame = queue[i];
+
+      // Guard against cycles in malformed trees
+      if (!visited.insert(frame).second) {
+        continue;
+      }
+
+      auto edge = this->edges.find(frame);
+      if (edge == this->edges.end()) {
+        this->rootPoses[frame] = {frame, math::Pose3d::Zero};
+      } else {
+        auto parent = this->rootPoses.find(edge->second.parent);
+        if (parent == this->rootPoses.end()) {
+          // Parent has not been published as a child, it is the root of the tree
+          parent = this->rootPoses.insert(
+            {edge->second.parent, {edge->second.parent, math::Pose3d::Zero}}).first;
+        }
+        this->rootPoses[frame] = {
+          parent->second.root, composePose(parent->second.pose, edge->second.pose)};
+      }
+      updated.push_back(frame);
+
+      auto children = this->childFrames.find(frame);
+      if (children != this->childFrames.end()) {
+        queue.insert(queue.end(), children->second.begin(), children->second.end());
+      }
+    }
+  }
+
+  // If the fixed frame has moved every frame of its tree moves relative to it
+  if (visited.count(this->workingTable.fixedFrame) > 0) {
+    updated.clear();
+    for (const auto & frame : this->rootPoses) {
+      updated.push_back(frame.first);
+    }
+  }
+
+  this->applyFixedFrame(updated);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Expresses root relative poses in the fixed frame, with one inverse
+ * composition per frame.
+ */
+void FrameManager::applyFixedFrame(const std::vector<std::string> & _frames)
+{
+  auto fixed = this->rootPoses.find(this->workingTable.fixedFrame);
+  const math::Pose3d fixedInverse = (fixed != this->rootPoses.end()) ?
+    fixed->second.pose.Inverse() : math::Pose3d::Zero;
+
+  for (const auto & frame : _frames) {
+    FrameEntry & entry = this->workingTable.frame(frame);
+    auto rootPose = this->rootPoses.find(frame);
+
+    entry.generation++;
+    if (fixed == this->rootPoses.end() || rootPose == this->rootPoses.end() ||
+      rootPose->second.root != fixed->second.root)
+    {
+      // Frame is not connected to the fixed frame
+      entry.resolved = false;
+      continue;
+    }
+
+    entry.pose = composePose(fixedInverse, rootPose->second.pose);
+    entry.resolved = true;
+    this->savedLookupCount++;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+size_t FrameManager::frameDepth(const std::string & _frame) const
+{
+  size_t depth = 0;
+  std::string frame = _frame;
+
+  // Bounded walk in case of cycles in malformed trees
+  for (; depth <= this->edges.size(); ++depth) {
+    auto it = this->edges.find(frame);
+    if (it == this->edges.end()) {
+      break;
+    }
+    frame = it->second.parent;
+  }
+
+  return depth;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::resetDynamicFrames()
+{
+  for (auto it = this->edges.begin(); it != this->edges.end(); ) {
+    if (this->staticEdges.count(it->first) > 0) {
+      ++it;
+      continue;
+    }
+
+    auto siblings = this->childFrames.find(it->second.parent);
+    if (siblings != this->childFrames.end()) {
+      siblings->second.erase(it->first);
+    }
+    it = this->edges.erase(it);
+  }
+
+  for (auto & shard : this->workingTable.shards) {
+    for (auto & frame : shard) {
+      frame.second.resolved = false;
+      frame.second.generation++;
+    }
+  }
+  this->workingTable.dirtyShards.set();
+  this->workingTable.stamp = tf2::TimePointZero;
+
+  // Root poses are recomputed from the remaining edges
+  this->rootPoses.clear();
+  this->fullRecompute = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::onTimeJump(const rcl_time_jump_t & _jump)
+{
+  if (_jump.clock_change == RCL_ROS_TIME_NO_CHANGE && _jump.delta.nanoseconds >= 0) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->tf_mutex_);
+
+    RCLCPP_INFO(this->node->get_logger(), "Time jumped backwards, clearing frames");
+    this->resetDynamicFrames();
+    if (!this->pullMode) {
+      this->updateFramePoses({});
+    }
+    this->publishTable();
+  }
+
+  this->invalidateStampedCache();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::invalidateStampedCache()
+{
+  // Cleared by the next render side lookup, the executor never takes render_mutex_
+  this->stampedCacheGeneration++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::syncStampedCache()
+{
+  const uint64_t generation = this->stampedCacheGeneration;
+  if (generation == this->clearedStampedCacheGeneration) {
+    return;
+  }
+
+  this->clearedStampedCacheGeneration = generation;
+  this->stampedCache.clear();
+  this->stampedCacheIndex.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::rebuildStaticChains()
+{
+  auto chains = std::make_shared<StaticChainMap>();
+
+  for (const auto & edge : this->staticEdges) {
+    StaticChain chain;
+    chain.anchor = edge.first;
+    chain.pose = math::Pose3d::Zero;
+
+    // Walk up through static edges, bounded in case of cycles in malformed trees
+    for (size_t i = 0; i < this->staticEdges.size(); ++i) {
+      auto it = this->staticEdges.find(chain.anchor);
+      if (it == this->staticEdges.end()) {
+        break;
+      }
+      chain.pose = composePose(it->second.second, chain.pose);
+      chain.anchor = it->second.first;
+    }
+
+    // Cycle of static transforms, leave it to the buffer
+    if (this->staticEdges.count(chain.anchor) > 0) {
+      continue;
     }
+
+    chains->insert({edge.first, chain});
   }
+
+  this->workingTable.staticChains = chains;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::updateEdge(
+  const geometry_msgs::msg::TransformStamped & _transform,
+  const tf2::TimePoint & _stamp)
+{
+  const std::string & parent = _transform.header.frame_id;
+  const std::string & child = _transform.child_frame_id;
+
+  // New frames change the frame list
+  for (const auto & frame : {parent, child}) {
+    if (!this->workingTable.hasFrame(frame)) {
+      this->markDirty(frame);
+      this->frameListGeneration++;
+    }
+  }
+
+  auto it = this->edges.find(child);
+  if (it == this->edges.end()) {
+    it = this->edges.insert({child, Edge()}).first;
+    it->second.parent = parent;
+    this->childFrames[parent].insert(child);
+  } else if (it->second.parent != parent) {
+    // Frame has been re-parented
+    this->childFrames[it->second.parent].erase(child);
+    this->childFrames[parent].insert(child);
+    it->second.parent = parent;
+  }
+
+  it->second.pose = transformToPose(_transform.transform);
+  it->second.stamp = _stamp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::invalidateSubtree(const std::string & _frame)
+{
+  std::vector<std::string> stack = {_frame};
+  std::unordered_set<std::string> visited;
+
+  while (!stack.empty()) {
+    std::string frame = std::move(stack.back());
+    stack.pop_back();
+
+    // Guard against cycles in malformed trees
+    if (!visited.insert(frame).second) {
+      continue;
+    }
+
+    this->markDirty(frame);
+
+    auto children = this->childFrames.find(frame);
+    if (children != this->childFrames.end()) {
+      stack.insert(stack.end(), children->second.begin(), children->second.end());
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FrameManager::isFixedFrameAncestor(const std::string & _frame) const
+{
+  std::string frame = this->workingTable.fixedFrame;
+
+  // Bounded walk in case of cycles in malformed trees
+  for (size_t i = 0; i <= this->edges.size(); ++i) {
+    if (frame == _frame) {
+      return true;
+    }
+
+    auto it = this->edges.find(frame);
+    if (it == this->edges.end()) {
+      return false;
+    }
+    frame = it->second.parent;
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * A frame is kept if it was updated within the timeout, if one of its
+ * descendants is kept, or if it is attached by a static transform to a kept
+ * parent. Frames connected to their root only through static transforms are
+ * latched once and never refreshed, so they are always kept. Evicted frames
+ * therefore always form complete subtrees.
+ */
+void FrameManager::evictStaleFrames()
+{
+  const int64_t timeout = this->frameTimeout;
+  if (timeout <= 0) {
+    return;
+  }
+
+  const int64_t cutoff = this->node->now().nanoseconds() - timeout;
+
+  std::lock_guard<std::mutex> lock(this->tf_mutex_);
+
+  std::unordered_set<std::string> kept;
+  std::vector<std::string> queue;
+
+  // Check if all transforms between a frame and its root are static
+  auto staticRooted = [this](const std::string & _frame) {
+      bool staticEdge = false;
+      std::string current = _frame;
+
+      // Bounded walk in case of cycles in malformed trees
+      for (size_t i = 0; i <= this->edges.size(); ++i) {
+        auto edge = this->edges.find(current);
+        if (edge == this->edges.end()) {
+          break;
+        }
+        if (this->staticEdges.count(current) == 0) {
+          return false;
+        }
+        staticEdge = true;
+        current = edge->second.parent;
+      }
+
+      return staticEdge;
+    };
+
+  // Keep recently updated and static rooted frames and all their ancestors
+  for (const auto & shard : this->workingTable.shards) {
+    for (const auto & frame : shard) {
+      if (frame.second.lastUpdate < cutoff && !staticRooted(frame.first)) {
+        continue;
+      }
+
+      std::string current = frame.first;
+      for (size_t i = 0; i <= this->edges.size() && kept.insert(current).second; ++i) {
+        queue.push_back(current);
+
+        auto edge = this->edges.find(current);
+        if (edge == this->edges.end()) {
+          break;
+        }
+        current = edge->second.parent;
+      }
+    }
+  }
+
+  // Static frames move with their parent and are kept as long as it is
+  for (size_t i = 0; i < queue.size(); ++i) {
+    auto children = this->childFrames.find(queue[i]);
+    if (children == this->childFrames.end()) {
+      continue;
+    }
+
+    for (const auto & child : children->second) {
+      if (this->staticEdges.count(child) > 0 && kept.insert(child).second) {
+        queue.push_back(child);
+      }
+    }
+  }
+
+  if (kept.size() == this->workingTable.frameCount()) {
+    return;
+  }
+
+  bool staticEdgesChanged = false;
+
+  for (size_t shard = 0; shard < kFrameShards; ++shard) {
+    FrameShard & frames = this->workingTable.shards[shard];
+
+    for (auto it = frames.begin(); it != frames.end(); ) {
+      const std::string & frame = it->first;
+
+      if (kept.count(frame) > 0) {
+        ++it;
+        continue;
+      }
+
+      auto edge = this->edges.find(frame);
+      if (edge != this->edges.end()) {
+        auto siblings = this->childFrames.find(edge->second.parent);
+        if (siblings != this->childFrames.end()) {
+          siblings->second.erase(frame);
+        }
+        this->edges.erase(edge);
+      }
+
+      staticEdgesChanged |= this->staticEdges.erase(frame) > 0;
+      this->childFrames.erase(frame);
+      this->rootPoses.erase(frame);
+
+      RCLCPP_DEBUG(this->node->get_logger(), "Evicting stale frame %s", frame.c_str());
+      it = frames.erase(it);
+      this->workingTable.dirtyShards.set(shard);
+    }
+  }
+
+  if (staticEdgesChanged) {
+    this->rebuildStaticChains();
+  }
+
+  this->publishTable();
+
+  // Pulled poses of evicted frames are dropped on the next render event
+  this->pulledPosesStale = true;
+
+  // Frame list changed event is delivered on the next render event
+  this->frameListGeneration++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::markDirty(const std::string & _frame)
+{
+  this->workingTable.frame(_frame).generation++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FrameManager::lookupFramePose(
+  const std::string & _fixedFrame, const std::string & _frame,
+  const tf2::TimePoint & _time, ignition::math::Pose3d & _pose)
+{
+  this->lookupCount++;
+
+  try {
+    /*
+     * TODO(Sarathkrishnan Ramesh): Reducing the tiemout for lookupTransform affects
+     * smoothness of tf visualization.
+     */
+    geometry_msgs::msg::TransformStamped tf = tfBuffer->lookupTransform(
+      _fixedFrame, _time,
+      _frame, _time,
+      _fixedFrame, tf2::Duration(5000));
+
+    _pose = transformToPose(tf.transform);
+
+    return true;
+  } catch (tf2::LookupException & e) {
+    RCLCPP_WARN(this->node->get_logger(), e.what());
+  } catch (tf2::ConnectivityException & e) {
+    RCLCPP_WARN(this->node->get_logger(), e.what());
+  } catch (tf2::ExtrapolationException & e) {
+    RCLCPP_WARN(this->node->get_logger(), e.what());
+  } catch (tf2::InvalidArgumentException & e) {
+    RCLCPP_WARN(this->node->get_logger(), e.what());
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::publishTable()
+{
+  const std::shared_ptr<const FrameTable> previous = std::atomic_load(&this->table);
+
+  auto published = std::make_shared<FrameTable>();
+  published->fixedFrame = this->workingTable.fixedFrame;
+  published->stamp = this->workingTable.stamp;
+  published->staticChains = this->workingTable.staticChains;
+
+  // Only modified shards are copied, the others are shared with the previous table
+  for (size_t i = 0; i < kFrameShards; ++i) {
+    if (!previous || this->workingTable.dirtyShards.test(i)) {
+      published->shards[i] = std::make_shared<const FrameShard>(this->workingTable.shards[i]);
+    } else {
+      published->shards[i] = previous->shards[i];
+    }
+  }
+  this->workingTable.dirtyShards.reset();
+
+  // Readers holding the previous table keep it alive until they are done
+  std::atomic_store(&this->table, std::shared_ptr<const FrameTable>(std::move(published)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool FrameManager::getFramePose(const std::string & _frame, ignition::math::Pose3d & _pose)
 {
-  std::lock_guard<std::mutex>(this->tf_mutex_);
+  return this->snapshotFramePose(std::atomic_load(&this->table), _frame, _pose);
+}
 
+////////////////////////////////////////////////////////////////////////////////
+bool FrameManager::getRelativePose(
+  const std::string & _target, const std::string & _source,
+  ignition::math::Pose3d & _pose)
+{
   _pose = math::Pose3d::Zero;
 
-  if (this->fixedFrame == _frame) {
+  if (_target == _source) {
     return true;
   }
 
-  auto it = this->tfTree.find(_frame);
-  if (it != tfTree.end()) {
-    _pose = it->second;
+  // Both poses are read from the same table, so they are consistent
+  const std::shared_ptr<const FrameTable> snapshot = std::atomic_load(&this->table);
+
+  math::Pose3d targetPose, sourcePose;
+  if (!this->snapshotFramePose(snapshot, _target, targetPose) ||
+    !this->snapshotFramePose(snapshot, _source, sourcePose))
+  {
+    return false;
+  }
+
+  _pose = composePose(targetPose.Inverse(), sourcePose);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FrameManager::snapshotFramePose(
+  const std::shared_ptr<const FrameTable> & _snapshot,
+  const std::string & _frame,
+  ignition::math::Pose3d & _pose)
+{
+  _pose = math::Pose3d::Zero;
+
+  if (_snapshot->fixedFrame == _frame) {
     return true;
   }
-  return false;
+
+  if (!this->pullMode) {
+    const FrameEntry * entry = _snapshot->findFrame(_frame);
+    if (entry != nullptr && entry->resolved) {
+      _pose = entry->pose;
+      return true;
+    }
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->render_mutex_);
+  return this->pullFramePose(_snapshot, _frame, _pose);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool FrameManager::getParentPose(const std::string & _child, ignition::math::Pose3d & _pose)
+bool FrameManager::pullFramePose(
+  const std::shared_ptr<const FrameTable> & _snapshot,
+  const std::string & _frame,
+  ignition::math::Pose3d & _pose)
+{
+  _pose = math::Pose3d::Zero;
+
+  if (_snapshot->fixedFrame == _frame) {
+    return true;
+  }
+
+  // A frame is resolved at most once per render tick
+  const StampedKey key{_snapshot->fixedFrame, _frame, tf2::TimePointZero};
+  auto memo = this->tickCache.find(key);
+  if (memo != this->tickCache.end()) {
+    _pose = memo->second;
+    return true;
+  }
+
+  if (this->pulledFixedFrame != _snapshot->fixedFrame) {
+    this->pulledPoses.clear();
+    this->pulledFixedFrame = _snapshot->fixedFrame;
+  }
+
+  auto chain = _snapshot->staticChains->find(_frame);
+  if (chain != _snapshot->staticChains->end()) {
+    // Static frames are composed from their anchor without a buffer lookup
+    math::Pose3d anchorPose;
+    if (!this->pullFramePose(_snapshot, chain->second.anchor, anchorPose)) {
+      return false;
+    }
+    this->savedLookupCount++;
+    _pose = composePose(anchorPose, chain->second.pose);
+  } else {
+    // Unknown and evicted frames are not resolved from the buffer
+    const FrameEntry * entry = _snapshot->findFrame(_frame);
+    if (entry == nullptr) {
+      return false;
+    }
+    const uint64_t generation = entry->generation;
+
+    // Reuse the previous result if the frame has not been invalidated since
+    auto pulled = this->pulledPoses.find(_frame);
+    if (pulled != this->pulledPoses.end() && pulled->second.first == generation) {
+      this->savedLookupCount++;
+      _pose = pulled->second.second;
+    } else {
+      // Latest common time of the chain, chains publishing at different rates
+      // must not be looked up at the stamp of the fastest one
+      if (!this->lookupFramePose(_snapshot->fixedFrame, _frame, tf2::TimePointZero, _pose)) {
+        return false;
+      }
+      this->pulledPoses[_frame] = std::make_pair(generation, _pose);
+    }
+  }
+
+  this->tickCache.insert({key, _pose});
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FrameManager::getFramePose(
+  const std::string & _frame,
+  const builtin_interfaces::msg::Time & _stamp,
+  ignition::math::Pose3d & _pose)
 {
-  std::lock_guard<std::mutex>(this->tf_mutex_);
+  const tf2::TimePoint stamp = stampToTimePoint(_stamp);
+
+  const std::string fixedFrame = this->getFixedFrame();
+
+  if (fixedFrame == _frame || stamp == tf2::TimePointZero) {
+    return this->getFramePose(_frame, _pose);
+  }
+
+  // The fixed frame is part of the key, so a lookup racing with a fixed frame
+  // change can never serve a pose expressed in the old fixed frame
+  const StampedKey key{fixedFrame, _frame, stamp};
+  uint64_t generation;
+
+  {
+    std::lock_guard<std::mutex> lock(this->render_mutex_);
+    this->syncStampedCache();
+    generation = this->clearedStampedCacheGeneration;
+
+    auto it = this->stampedCacheIndex.find(key);
+    if (it != this->stampedCacheIndex.end()) {
+      // Move entry to front of the LRU list
+      this->stampedCache.splice(this->stampedCache.begin(), this->stampedCache, it->second);
+      _pose = it->second->second;
+      return true;
+    }
+  }
 
+  this->lookupCount++;
+
+  try {
+    geometry_msgs::msg::TransformStamped tf = tfBuffer->lookupTransform(
+      fixedFrame, _frame, stamp, tf2::Duration(5000));
+
+    _pose = transformToPose(tf.transform);
+  } catch (tf2::TransformException & e) {
+    // Stamp outside of buffer history, the latest pose would be wrong for the stamp
+    RCLCPP_DEBUG(this->node->get_logger(), e.what());
+    _pose = math::Pose3d::Zero;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->render_mutex_);
+
+  // Do not cache a pose looked up before the cache was invalidated
+  this->syncStampedCache();
+  if (generation != this->clearedStampedCacheGeneration) {
+    return true;
+  }
+
+  if (this->stampedCacheIndex.find(key) == this->stampedCacheIndex.end()) {
+    this->stampedCache.emplace_front(key, _pose);
+    this->stampedCacheIndex[key] = this->stampedCache.begin();
+  }
+
+  while (this->stampedCache.size() > this->stampedCacheSize) {
+    this->stampedCacheIndex.erase(this->stampedCache.back().first);
+    this->stampedCache.pop_back();
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameManager::setStampedCacheSize(size_t _size)
+{
+  std::lock_guard<std::mutex> lock(this->render_mutex_);
+  this->stampedCacheSize = _size;
+
+  while (this->stampedCache.size() > this->stampedCacheSize) {
+    this->stampedCacheIndex.erase(this->stampedCache.back().first);
+    this->stampedCache.pop_back();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FrameManager::getParentPose(const std::string & _child, ignition::math::Pose3d & _pose)
+{
   std::string parent;
-  bool parentAvailable = tfBuffer->_getParent(_child, this->timePoint, parent);
+  bool parentAvailable = tfBuffer->_getParent(_child, tf2::TimePointZero, parent);
 
   if (!parentAvailable) {
     return false;
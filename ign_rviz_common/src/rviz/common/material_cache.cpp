@@ -0,0 +1,130 @@
+// Copyright (c) 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ignition/rviz/common/material_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+namespace ignition
+{
+namespace rviz
+{
+namespace common
+{
+////////////////////////////////////////////////////////////////////////////////
+static uint32_t quantize(float _value)
+{
+  const float value = std::min(std::max(_value, 0.0f), 1.0f);
+  return static_cast<uint32_t>(std::lround(value * 255.0f));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static float channel(uint32_t _key, int _shift)
+{
+  return ((_key >> _shift) & 0xff) / 255.0f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::shared_ptr<MaterialCache> MaterialCache::instance(rendering::ScenePtr _scene)
+{
+  static std::mutex instanceMutex;
+  static std::weak_ptr<MaterialCache> shared;
+
+  std::lock_guard<std::mutex> guard(instanceMutex);
+
+  auto cache = shared.lock();
+  if (!cache || cache->scene != _scene) {
+    cache = std::make_shared<MaterialCache>(std::move(_scene));
+    shared = cache;
+  }
+
+  return cache;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MaterialCache::MaterialCache(rendering::ScenePtr _scene)
+: scene(std::move(_scene)) {}
+
+////////////////////////////////////////////////////////////////////////////////
+MaterialCache::~MaterialCache()
+{
+  for (auto & entry : this->materials) {
+    this->scene->DestroyMaterial(entry.second.material);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+rendering::MaterialPtr MaterialCache::acquire(const std_msgs::msg::ColorRGBA & _color)
+{
+  const uint32_t key = quantize(_color.r) << 24 | quantize(_color.g) << 16 |
+    quantize(_color.b) << 8 | quantize(_color.a);
+
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  auto it = this->materials.find(key);
+  if (it != this->materials.end()) {
+    it->second.references++;
+    return it->second.material;
+  }
+
+  // Use the quantized color, so that the material does not depend on which
+  // of the matching colors created it
+  const float r = channel(key, 24), g = channel(key, 16), b = channel(key, 8), a = channel(key, 0);
+
+  auto material = this->scene->CreateMaterial();
+  material->SetAmbient(r, g, b, a);
+  material->SetDiffuse(r, g, b, a);
+  material->SetEmissive(r, g, b, a);
+
+  this->materials.emplace(key, CacheEntry{material, 1});
+  this->colors.emplace(material.get(), key);
+
+  return material;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MaterialCache::release(const rendering::MaterialPtr & _material)
+{
+  if (!_material) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(this->mutex);
+
+  auto color = this->colors.find(_material.get());
+  if (color == this->colors.end()) {
+    return;
+  }
+
+  auto it = this->materials.find(color->second);
+  if (--it->second.references == 0) {
+    this->scene->DestroyMaterial(it->second.material);
+    this->materials.erase(it);
+    this->colors.erase(color);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t MaterialCache::size() const
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+  return this->materials.size();
+}
+
+}  // namespace common
+}  // namespace rviz
+}  // namespace ignition
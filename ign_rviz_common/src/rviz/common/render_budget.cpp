@@ -0,0 +1,92 @@
+// Copyright (c) 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ignition/rviz/common/render_budget.hpp"
+
+#include <ignition/gui/GuiEvents.hh>
+
+namespace ignition
+{
+namespace rviz
+{
+namespace common
+{
+constexpr unsigned int RenderBudget::kMaxSkippedFrames;
+
+////////////////////////////////////////////////////////////////////////////////
+RenderBudget::RenderBudget(const std::chrono::nanoseconds & _budget)
+: budget(_budget.count()), lastFrameTime(0), skippedUpdates(0), spent(0) {}
+
+////////////////////////////////////////////////////////////////////////////////
+void RenderBudget::setBudget(const std::chrono::nanoseconds & _budget)
+{
+  this->budget = _budget.count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::chrono::nanoseconds RenderBudget::getBudget() const
+{
+  return std::chrono::nanoseconds(this->budget);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool RenderBudget::acquire(Priority _priority, unsigned int _skippedFrames)
+{
+  const int64_t limit = this->budget;
+  if (limit <= 0 || _priority == Priority::High || _skippedFrames >= kMaxSkippedFrames) {
+    return true;
+  }
+
+  const int64_t available = (_priority == Priority::Low) ? limit / 2 : limit;
+  if (this->spent < available) {
+    return true;
+  }
+
+  this->skippedUpdates++;
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RenderBudget::release(const std::chrono::nanoseconds & _elapsed)
+{
+  this->spent += _elapsed.count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::chrono::nanoseconds RenderBudget::getLastFrameTime() const
+{
+  return std::chrono::nanoseconds(this->lastFrameTime);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+uint64_t RenderBudget::getSkippedUpdates() const
+{
+  return this->skippedUpdates;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool RenderBudget::eventFilter(QObject * _object, QEvent * _event)
+{
+  if (_event->type() == gui::events::Render::kType) {
+    // Displays have been updated, start a new frame
+    this->lastFrameTime = this->spent;
+    this->spent = 0;
+  }
+
+  return QObject::eventFilter(_object, _event);
+}
+
+}  // namespace common
+}  // namespace rviz
+}  // namespace ignition
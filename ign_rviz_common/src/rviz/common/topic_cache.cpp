@@ -0,0 +1,109 @@
+// Copyright (c) 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ignition/rviz/common/topic_cache.hpp"
+
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ignition
+{
+namespace rviz
+{
+namespace common
+{
+////////////////////////////////////////////////////////////////////////////////
+TopicCache::TopicCache(rclcpp::Node::SharedPtr _node)
+: node(std::move(_node)), index(std::make_shared<const TopicIndex>()), generation(0),
+  running(true)
+{
+  this->refresh();
+  this->thread = std::thread(&TopicCache::run, this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TopicCache::~TopicCache()
+{
+  this->running = false;
+  if (this->thread.joinable()) {
+    this->thread.join();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> TopicCache::getTopics(const std::string & _type) const
+{
+  const std::shared_ptr<const TopicIndex> snapshot = std::atomic_load(&this->index);
+
+  auto it = snapshot->find(_type);
+  if (it == snapshot->end()) {
+    return {};
+  }
+
+  return it->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+uint64_t TopicCache::getGeneration() const
+{
+  return this->generation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TopicCache::refresh()
+{
+  std::lock_guard<std::mutex> guard(this->refreshMutex);
+
+  auto updated = std::make_shared<TopicIndex>();
+
+  // Topics are sorted by name, so are the topics of each type
+  const auto topics = this->node->get_topic_names_and_types();
+  for (const auto & topic : topics) {
+    for (const auto & topicType : topic.second) {
+      (*updated)[topicType].push_back(topic.first);
+    }
+  }
+
+  std::atomic_store(&this->index, std::shared_ptr<const TopicIndex>(std::move(updated)));
+  this->generation++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TopicCache::run()
+{
+  rclcpp::Event::SharedPtr graphEvent = this->node->get_graph_event();
+
+  while (this->running && rclcpp::ok()) {
+    try {
+      // Wake up regularly to notice destruction
+      this->node->wait_for_graph_change(graphEvent, std::chrono::milliseconds(100));
+
+      if (graphEvent->check_and_clear()) {
+        this->refresh();
+      }
+    } catch (const std::exception & e) {
+      // Graph listener is shut down with the context
+      RCLCPP_DEBUG(this->node->get_logger(), "Topic cache stopped: %s", e.what());
+      return;
+    }
+  }
+}
+
+}  // namespace common
+}  // namespace rviz
+}  // namespace ignition
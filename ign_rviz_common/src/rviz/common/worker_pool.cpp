@@ -0,0 +1,101 @@
+// Copyright (c) 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ignition/rviz/common/worker_pool.hpp"
+
+#include <utility>
+
+namespace ignition
+{
+namespace rviz
+{
+namespace common
+{
+////////////////////////////////////////////////////////////////////////////////
+WorkerPool::WorkerPool(unsigned int _threads)
+: stopping(false)
+{
+  if (_threads == 0) {
+    // Leave one hardware thread to the render loop
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    _threads = (hardwareThreads > 1) ? hardwareThreads - 1 : 1;
+  }
+
+  this->threads.reserve(_threads);
+  for (unsigned int i = 0; i < _threads; ++i) {
+    this->threads.emplace_back(&WorkerPool::run, this);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> guard(this->mutex);
+    this->stopping = true;
+    this->tasks.clear();
+  }
+  this->condition.notify_all();
+
+  for (auto & thread : this->threads) {
+    thread.join();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkerPool::post(std::function<void()> _task)
+{
+  {
+    std::lock_guard<std::mutex> guard(this->mutex);
+    if (this->stopping) {
+      return;
+    }
+    this->tasks.push_back(std::move(_task));
+  }
+  this->condition.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned int WorkerPool::threadCount() const
+{
+  return this->threads.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkerPool::run()
+{
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> guard(this->mutex);
+      this->condition.wait(
+        guard, [this]() {
+          return this->stopping || !this->tasks.empty();
+        });
+
+      if (this->stopping) {
+        return;
+      }
+
+      task = std::move(this->tasks.front());
+      this->tasks.pop_front();
+    }
+
+    task();
+  }
+}
+
+}  // namespace common
+}  // namespace rviz
+}  // namespace ignition
@@ -59,7 +59,7 @@ public:
   void initialize(rclcpp::Node::SharedPtr _node) override;
 
   // Documentation Inherited
-  void callback(const sensor_msgs::msg::NavSatFix::SharedPtr _msg) override;
+  void callback(const sensor_msgs::msg::NavSatFix::ConstSharedPtr _msg) override;
 
   // Documentation inherited
   void setTopic(const std::string & topic_name) override;
@@ -122,7 +122,7 @@ public slots:
   void onRefresh();
 
 private:
-  std::mutex lock;
+  std::recursive_mutex lock;
   QStringList topicList;
 };
 
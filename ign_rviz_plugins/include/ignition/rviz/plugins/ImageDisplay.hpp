@@ -77,7 +77,7 @@ private:
 /**
  * @brief ImageDisplay plugin renders image received as ROS message
  */
-class ImageDisplay : public MessageDisplay<sensor_msgs::msg::Image>
+class ImageDisplay : public PreparedMessageDisplay<sensor_msgs::msg::Image, QImage>
 {
   Q_OBJECT
 
@@ -104,7 +104,7 @@ public:
   void initialize(rclcpp::Node::SharedPtr _node) override;
 
   // Documentation Inherited
-  void callback(const sensor_msgs::msg::Image::SharedPtr _msg) override;
+  void callback(const sensor_msgs::msg::Image::ConstSharedPtr _msg) override;
 
   // Documentation inherited
   void setTopic(const std::string & topic_name) override;
@@ -163,28 +163,39 @@ signals:
    */
   void newImage();
 
+protected:
+  // Documentation inherited
+  PreparedPtr prepare(const sensor_msgs::msg::Image & _msg) override;
+
+  // Documentation inherited
+  void onPrepared() override;
+
+  /**
+   * @brief Show the latest prepared image
+   */
+  void update() override;
+
 private:
   // Handle image with rgb8 encoding
-  void updateFromRGB8();
+  static QImage convertFromRGB8(const sensor_msgs::msg::Image & _msg);
 
   // Handle image with bgr8 encoding
-  void updateFromBGR8();
+  static QImage convertFromBGR8(const sensor_msgs::msg::Image & _msg);
 
   // Handle image with mono8 encoding
-  void updateFromMONO8();
+  static QImage convertFromMONO8(const sensor_msgs::msg::Image & _msg);
 
   // Handle image with mono16 encoding
-  void updateFromMONO16();
+  static QImage convertFromMONO16(const sensor_msgs::msg::Image & _msg);
 
   // Handle image with float32 encoding
-  void updateFromFloat32();
+  static QImage convertFromFloat32(const sensor_msgs::msg::Image & _msg);
 
 public:
   ImageProvider * provider{nullptr};
 
 private:
   std::recursive_mutex lock;
-  sensor_msgs::msg::Image::SharedPtr msg;
   QStringList topicList;
 };
 
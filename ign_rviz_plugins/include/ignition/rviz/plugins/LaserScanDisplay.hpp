@@ -18,6 +18,7 @@
 #include <ignition/rendering.hh>
 
 #include <sensor_msgs/msg/laser_scan.hpp>
+#include <std_msgs/msg/header.hpp>
 
 #include <string>
 #include <mutex>
@@ -32,11 +33,24 @@ namespace rviz
 {
 namespace plugins
 {
+/**
+ * @brief Laser scan converted for LidarVisual
+ */
+struct LaserScanData
+{
+  std_msgs::msg::Header header;
+  double angleMin;
+  double angleMax;
+  double rangeMin;
+  double rangeMax;
+  std::vector<double> ranges;
+};
+
 /**
  * @brief Renders data from sensor_msgs::msg::LaserScanDisplay message as points in the world,
  * drawn as points, rays and triangles.
  */
-class LaserScanDisplay : public MessageDisplay<sensor_msgs::msg::LaserScan>
+class LaserScanDisplay : public PreparedMessageDisplay<sensor_msgs::msg::LaserScan, LaserScanData>
 {
   Q_OBJECT
 
@@ -65,7 +79,7 @@ public:
   void initialize(rclcpp::Node::SharedPtr _node) override;
 
   // Documentation Inherited
-  void callback(const sensor_msgs::msg::LaserScan::SharedPtr _msg) override;
+  void callback(const sensor_msgs::msg::LaserScan::ConstSharedPtr _msg) override;
 
   // Documentation inherited
   void setTopic(const std::string & topic_name) override;
@@ -139,15 +153,21 @@ protected:
    */
   void update();
 
+  // Documentation inherited
+  PreparedPtr prepare(const sensor_msgs::msg::LaserScan & _msg) override;
+
 private:
   ignition::rendering::RenderEngine * engine;
   ignition::rendering::ScenePtr scene;
   ignition::rendering::LidarVisualPtr rootVisual;
-  std::mutex lock;
+  std::recursive_mutex lock;
   std::string fixedFrame;
-  sensor_msgs::msg::LaserScan::SharedPtr msg;
+  PreparedPtr data;
   QStringList topicList;
   enum rendering::LidarVisualType visualType;
+
+  // Whether the current scan must be uploaded to the visual
+  bool dirty;
 };
 
 }  // namespace plugins
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "ignition/rviz/plugins/MarkerManager.hpp"
+#include "ignition/rviz/plugins/MarkerQueue.hpp"
 #include "ignition/rviz/plugins/message_display_base.hpp"
 
 namespace ignition
@@ -65,7 +66,7 @@ public:
   void initialize(rclcpp::Node::SharedPtr _node) override;
 
   // Documentation Inherited
-  void callback(const visualization_msgs::msg::MarkerArray::SharedPtr _msg) override;
+  void callback(const visualization_msgs::msg::MarkerArray::ConstSharedPtr _msg) override;
 
   // Documentation inherited
   void setTopic(const std::string & topic_name) override;
@@ -128,16 +129,22 @@ public slots:
   void onRefresh();
 
 protected:
+  /**
+   * @brief Record statistics of a received message and queue its markers
+   * @param[in] _msg: Received message
+   */
+  void receive(visualization_msgs::msg::MarkerArray::ConstSharedPtr _msg) override;
+
   /**
    * @brief Update MarkerArray data visualization
    */
   void update() override;
 
 private:
-  std::mutex lock;
-  visualization_msgs::msg::MarkerArray::SharedPtr msg;
+  std::recursive_mutex lock;
   QStringList topicList;
   std::unique_ptr<MarkerManager> markerManager;
+  MarkerQueue markerQueue;
 };
 
 }  // namespace plugins
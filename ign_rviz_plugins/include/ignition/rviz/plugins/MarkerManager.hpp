@@ -17,12 +17,23 @@
 
 #include <ignition/rendering.hh>
 
+#include <builtin_interfaces/msg/time.hpp>
 #include <geometry_msgs/msg/pose.hpp>
 #include <std_msgs/msg/color_rgba.hpp>
 #include <visualization_msgs/msg/marker.hpp>
 #include <visualization_msgs/msg/marker_array.hpp>
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ignition/rviz/common/frame_manager.hpp"
+#include "ignition/rviz/common/material_cache.hpp"
 
 namespace ignition
 {
@@ -40,11 +51,21 @@ public:
   ~MarkerManager();
 
   /**
-   * @brief Insert or Update a new marker visual with same ID
-   * @param[in] _id Marker ID
-   * @param[in] _visual Marker visual
+   * @brief Set frame manager used to place markers in their header frame
+   * @param[in] _frameManager Frame manager, markers stay in the fixed frame if null
+   */
+  void setFrameManager(std::shared_ptr<common::FrameManager> _frameManager);
+
+  /**
+   * @brief Place all markers again on the next update, e.g. after the fixed frame changed.
+   * Markers whose stamp is no longer buffered are placed with the latest transform.
    */
-  void insertOrUpdateVisual(unsigned int _id, rendering::VisualPtr _visual);
+  void resetPoses();
+
+  /**
+   * @brief Remove expired markers and move frame locked markers. Called once per frame.
+   */
+  void update();
 
   /**
    * @brief Processes message to handle Add/Modify, Delete and Delete All marker actions
@@ -60,6 +81,10 @@ public:
 
   /**
    * @brief Creates marker visual using message
+   *
+   * A marker which already exists with the same type is updated in place,
+   * only the properties which changed are applied to its rendering objects.
+   *
    * @param[in] _msg Marker message
    */
   void createMarker(const visualization_msgs::msg::Marker & _msg);
@@ -113,16 +138,22 @@ public:
    * Handles the following geometry types:
    * Cube List and Sphere List
    *
+   * All shapes are drawn by a single triangle list with per vertex colors, so
+   * the list uses one scene node and one draw call. Marker geometry is unlit,
+   * so each face gets a fixed shade as if lit from above, independent of the
+   * scene lights. Lists with more shapes than the limit are truncated and an
+   * error naming the marker is logged.
+   *
    * @param[in] _msg Marker message
    */
   void createListVisual(const visualization_msgs::msg::Marker & _msg);
 
   /**
-   * @brief Create a new material from message
+   * @brief Get material of a color from the shared material cache
    * @param[in] _color Color message
-   * @return Material Material created using color message
+   * @return Material Shared material, released when the marker is destroyed
    */
-  rendering::MaterialPtr createMaterial(const std_msgs::msg::ColorRGBA & _color);
+  rendering::MaterialPtr acquireMaterial(const std_msgs::msg::ColorRGBA & _color);
 
   /**
    * @brief Convert pose message
@@ -133,20 +164,210 @@ public:
 
   /**
    * @brief Delete a specific marker from scene
+   * @param[in] _ns Marker namespace
    * @param[in] _id Marker ID
    */
-  void deleteMarker(unsigned int _id);
+  void deleteMarker(const std::string & _ns, int _id);
 
   /**
    * @brief Delete all the markers from scene
    */
   void deleteAllMarkers();
 
+private:
+  /**
+   * @brief Markers are identified by namespace and ID
+   */
+  struct MarkerKey
+  {
+    std::string ns;
+    int id;
+
+    bool operator==(const MarkerKey & _other) const
+    {
+      return this->id == _other.id && this->ns == _other.ns;
+    }
+  };
+
+  struct MarkerKeyHash
+  {
+    std::size_t operator()(const MarkerKey & _key) const
+    {
+      const std::size_t seed = std::hash<std::string>()(_key.ns);
+      return seed ^ (std::hash<int>()(_key.id) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    }
+  };
+
+  struct MarkerEntry
+  {
+    /// Placed at the marker frame, parent of the marker visual
+    rendering::VisualPtr frameVisual;
+    rendering::VisualPtr visual;
+    /// Geometry of basic and list markers
+    rendering::MarkerPtr geometry;
+    rendering::TextPtr text;
+    /// Material of the marker color, null if none
+    rendering::MaterialPtr material;
+    /// Last applied message, updates are compared against it
+    visualization_msgs::msg::Marker msg;
+    std::string frameId;
+    builtin_interfaces::msg::Time stamp;
+    bool frameLocked;
+    bool poseValid;
+    /// Failed frame pose lookups since the pose was last placed or invalidated
+    unsigned int poseRetries;
+    /// Whether the frame visual is shown, false until the marker was placed once
+    bool visible;
+    /// Whether the shapes of a shape list exceed the merged shape limit
+    bool truncated;
+    /// Steady clock time in nanoseconds at which the marker expires, zero for never
+    int64_t expiry;
+    /// Changes on every insertion, invalidates older expiry heap entries
+    uint64_t generation;
+  };
+
+  struct MarkerExpiry
+  {
+    int64_t time;
+    uint64_t generation;
+    MarkerKey key;
+
+    bool operator>(const MarkerExpiry & _other) const
+    {
+      return this->time > _other.time;
+    }
+  };
+
+  using MarkerMap = std::unordered_map<MarkerKey, MarkerEntry, MarkerKeyHash>;
+
+  /**
+   * @brief Insert or Update a new marker visual with same namespace and ID
+   *
+   * The visual is attached to the marker frame and the marker lifetime is restarted.
+   *
+   * @param[in] _msg Marker message
+   * @param[in] _visual Marker visual
+   * @return Marker entry, its geometry and material are filled in by the caller
+   */
+  MarkerEntry & insertOrUpdateVisual(
+    const visualization_msgs::msg::Marker & _msg, rendering::VisualPtr _visual);
+
+  /**
+   * @brief Check if an existing marker can be updated in place
+   * @param[in] _previous Last message applied to the marker
+   * @param[in] _msg New marker message
+   * @return True if the rendering objects can be reused, false to recreate them
+   */
+  bool canUpdate(
+    const visualization_msgs::msg::Marker & _previous,
+    const visualization_msgs::msg::Marker & _msg) const;
+
+  /**
+   * @brief Apply changed properties of a message to an existing marker
+   * @param[in] _key Marker key
+   * @param[in] _entry Marker entry
+   * @param[in] _msg Marker message
+   */
+  void updateMarker(
+    const MarkerKey & _key, MarkerEntry & _entry, const visualization_msgs::msg::Marker & _msg);
+
+  /**
+   * @brief Update frame and lifetime of a marker from its message
+   * @param[in] _key Marker key
+   * @param[in] _entry Marker entry
+   * @param[in] _msg Marker message
+   */
+  void trackMarker(
+    const MarkerKey & _key, MarkerEntry & _entry, const visualization_msgs::msg::Marker & _msg);
+
+  /**
+   * @brief Set marker visual pose from message
+   * @param[in] _visual Marker visual
+   * @param[in] _msg Marker message
+   */
+  void setVisualPose(rendering::VisualPtr _visual, const visualization_msgs::msg::Marker & _msg);
+
+  /**
+   * @brief Add points of a list marker message to its geometry
+   * @param[in] _geometry Marker geometry
+   * @param[in] _msg Marker message
+   * @param[in] _first Index of the first point to add
+   */
+  void addListPoints(
+    rendering::MarkerPtr _geometry, const visualization_msgs::msg::Marker & _msg,
+    size_t _first = 0);
+
+  /**
+   * @brief Update points of a list marker, moving only the changed points and
+   * appending the new ones if possible. This avoids rebuilding the list, but
+   * the geometry uploads all of its vertices again.
+   * @param[in] _entry Marker entry
+   * @param[in] _msg Marker message
+   */
+  void updateListPoints(MarkerEntry & _entry, const visualization_msgs::msg::Marker & _msg);
+
+  /**
+   * @brief Add shapes of a cube or sphere list message to its merged geometry
+   * @param[in] _entry Marker entry
+   * @param[in] _msg Marker message
+   * @param[in] _first Index of the first shape to add
+   */
+  void addListShapes(
+    MarkerEntry & _entry, const visualization_msgs::msg::Marker & _msg,
+    size_t _first = 0);
+
+  /**
+   * @brief Update shapes of a merged cube or sphere list, moving only the changed shapes
+   * and appending the new ones if possible. The geometry still uploads all of its vertices.
+   * @param[in] _entry Marker entry
+   * @param[in] _msg Marker message
+   */
+  void updateListShapes(MarkerEntry & _entry, const visualization_msgs::msg::Marker & _msg);
+
+  /**
+   * @brief Place a marker in its frame. Markers which are not frame locked use the transform at
+   * their stamp and fall back to the latest transform if it does not become available.
+   * @param[in] _entry Marker entry
+   */
+  void updateFramePose(MarkerEntry & _entry);
+
+  /**
+   * @brief Add marker expiry to the heap, compacting the heap if it holds too many stale entries
+   * @param[in] _key Marker key
+   * @param[in] _entry Marker entry
+   */
+  void scheduleExpiry(const MarkerKey & _key, const MarkerEntry & _entry);
+
+  /**
+   * @brief Release all materials acquired by a marker
+   * @param[in] _entry Marker entry
+   */
+  void releaseMaterials(MarkerEntry & _entry);
+
+  /**
+   * @brief Destroy marker visuals and remove it from the store
+   * @param[in] _it Marker to remove
+   * @return Iterator following the removed marker
+   */
+  MarkerMap::iterator destroyMarker(MarkerMap::iterator _it);
+
 private:
   ignition::rendering::RenderEngine * engine;
   ignition::rendering::ScenePtr scene;
   ignition::rendering::VisualPtr rootVisual;
-  std::unordered_map<unsigned int, rendering::VisualPtr> visuals;
+  std::shared_ptr<common::FrameManager> frameManager;
+  std::shared_ptr<common::MaterialCache> materialCache;
+
+  MarkerMap markers;
+
+  /// Min-heap of marker expiry times, stale entries are skipped when popped
+  std::priority_queue<MarkerExpiry, std::vector<MarkerExpiry>,
+    std::greater<MarkerExpiry>> expiries;
+
+  /// Markers which need a frame pose update on the next frame
+  std::unordered_set<MarkerKey, MarkerKeyHash> trackedMarkers;
+
+  uint64_t generation;
 };
 }  // namespace plugins
 }  // namespace rviz
@@ -0,0 +1,133 @@
+// Copyright (c) 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IGNITION__RVIZ__PLUGINS__MARKERQUEUE_HPP_
+#define IGNITION__RVIZ__PLUGINS__MARKERQUEUE_HPP_
+
+#include <visualization_msgs/msg/marker.hpp>
+#include <visualization_msgs/msg/marker_array.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ignition
+{
+namespace rviz
+{
+namespace plugins
+{
+/**
+ * @brief Bounded queue of received markers, coalesced by namespace and ID
+ *
+ * Every marker message changes the state of one marker, so only the latest
+ * pending message of each marker is kept and a DELETEALL discards everything
+ * queued before it. The queue thus holds at most one message per marker and
+ * its size does not grow with the message rate. Markers beyond the capacity
+ * are dropped.
+ *
+ * The subscriber posts markers and the render thread takes them.
+ */
+class MarkerQueue
+{
+public:
+  using MarkerPtr = std::shared_ptr<const visualization_msgs::msg::Marker>;
+
+  /**
+   * @brief Constructor
+   * @param[in] _capacity Maximum number of pending markers
+   */
+  explicit MarkerQueue(size_t _capacity = 100000);
+
+  /**
+   * @brief Queue a marker
+   * @param[in] _marker Received marker
+   * @param[in] _receiveTime Reception time of the marker
+   */
+  void post(MarkerPtr _marker, int64_t _receiveTime);
+
+  /**
+   * @brief Queue all markers of an array, sharing the array instead of copying them
+   * @param[in] _msg Received marker array
+   * @param[in] _receiveTime Reception time of the array
+   */
+  void post(
+    const visualization_msgs::msg::MarkerArray::ConstSharedPtr & _msg, int64_t _receiveTime);
+
+  /**
+   * @brief Take all pending markers
+   * @param[out] _markers Markers in the order they must be applied
+   * @param[out] _receiveTime Reception time of the latest taken message
+   * @return True if markers were taken
+   */
+  bool take(std::vector<MarkerPtr> & _markers, int64_t & _receiveTime);
+
+  /**
+   * @brief Discard all pending markers
+   */
+  void clear();
+
+  /**
+   * @brief Get number of dropped markers
+   * @return Markers replaced before they were taken or dropped for lack of capacity
+   */
+  uint64_t dropped() const;
+
+private:
+  /**
+   * @brief Queue a marker. Caller must hold the mutex.
+   * @param[in] _marker Received marker
+   */
+  void push(MarkerPtr _marker);
+
+  struct MarkerKey
+  {
+    std::string ns;
+    int id;
+
+    bool operator==(const MarkerKey & _other) const
+    {
+      return this->id == _other.id && this->ns == _other.ns;
+    }
+  };
+
+  struct MarkerKeyHash
+  {
+    std::size_t operator()(const MarkerKey & _key) const
+    {
+      const std::size_t seed = std::hash<std::string>()(_key.ns);
+      return seed ^ (std::hash<int>()(_key.id) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    }
+  };
+
+  const size_t capacity;
+
+  // Guards the pending markers and the reception time
+  std::mutex mutex;
+  std::vector<MarkerPtr> pending;
+  std::unordered_map<MarkerKey, size_t, MarkerKeyHash> index;
+  int64_t lastReceiveTime;
+
+  std::atomic<uint64_t> droppedCount;
+};
+}  // namespace plugins
+}  // namespace rviz
+}  // namespace ignition
+
+#endif  // IGNITION__RVIZ__PLUGINS__MARKERQUEUE_HPP_
@@ -66,7 +66,7 @@ public:
   void initialize(rclcpp::Node::SharedPtr _node) override;
 
   // Documentation inherited
-  void callback(const nav_msgs::msg::Path::SharedPtr _msg) override;
+  void callback(const nav_msgs::msg::Path::ConstSharedPtr _msg) override;
 
   // Documentation inherited
   void setTopic(const std::string & topic_name) override;
@@ -193,8 +193,12 @@ private:
   ignition::rendering::RenderEngine * engine;
   ignition::rendering::ScenePtr scene;
   ignition::rendering::VisualPtr rootVisual;
-  std::mutex lock;
-  nav_msgs::msg::Path::SharedPtr msg;
+  std::recursive_mutex lock;
+  nav_msgs::msg::Path::ConstSharedPtr msg;
+
+  // Message or properties changed since the last upload
+  bool dataChanged{false};
+
   QStringList topicList;
   bool dirty;
   int visualShape;  // 0: None; 1: Arrow; 2: Axis
@@ -67,7 +67,7 @@ public:
   void initialize(rclcpp::Node::SharedPtr _node) override;
 
   // Documentation Inherited
-  void callback(const geometry_msgs::msg::PointStamped::SharedPtr _msg) override;
+  void callback(const geometry_msgs::msg::PointStamped::ConstSharedPtr _msg) override;
 
   // Documentation inherited
   void setTopic(const std::string & topic_name) override;
@@ -157,7 +157,7 @@ protected:
    * @brief Create a new PointStamped visual
    * @param[in] _msg PointStamped data to visualize
    */
-  void createNewPointVisual(const geometry_msgs::msg::PointStamped::SharedPtr _msg);
+  void createNewPointVisual(const geometry_msgs::msg::PointStamped::ConstSharedPtr _msg);
 
   /**
    * @brief Removes the oldest PointStamped visual
@@ -170,8 +170,8 @@ private:
   ignition::rendering::VisualPtr rootVisual;
   ignition::rendering::MaterialPtr mat;
   std::deque<ignition::rendering::VisualPtr> visuals;
-  std::mutex lock;
-  geometry_msgs::msg::PointStamped::SharedPtr msg;
+  std::recursive_mutex lock;
+  geometry_msgs::msg::PointStamped::ConstSharedPtr msg;
   QStringList topicList;
   std::size_t historyLength;
   float radius;
@@ -64,7 +64,7 @@ public:
   void initialize(rclcpp::Node::SharedPtr _node) override;
 
   // Documentation inherited
-  void callback(const geometry_msgs::msg::PolygonStamped::SharedPtr _msg) override;
+  void callback(const geometry_msgs::msg::PolygonStamped::ConstSharedPtr _msg) override;
 
   // Documentation inherited
   void setTopic(const std::string & topic_name) override;
@@ -142,8 +142,12 @@ private:
   ignition::rendering::RenderEngine * engine;
   ignition::rendering::ScenePtr scene;
   ignition::rendering::VisualPtr rootVisual;
-  std::mutex lock;
-  geometry_msgs::msg::PolygonStamped::SharedPtr msg;
+  std::recursive_mutex lock;
+  geometry_msgs::msg::PolygonStamped::ConstSharedPtr msg;
+
+  // Message or properties changed since the last upload
+  bool dataChanged{false};
+
   QStringList topicList;
   math::Color color;
   bool createMarker;
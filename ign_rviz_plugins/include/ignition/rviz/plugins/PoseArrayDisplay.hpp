@@ -66,7 +66,7 @@ public:
   void initialize(rclcpp::Node::SharedPtr _node) override;
 
   // Documentation inherited
-  void callback(const geometry_msgs::msg::PoseArray::SharedPtr _msg) override;
+  void callback(const geometry_msgs::msg::PoseArray::ConstSharedPtr _msg) override;
 
   // Documentation inherited
   void setTopic(const std::string & topic_name) override;
@@ -179,8 +179,12 @@ private:
   ignition::rendering::RenderEngine * engine;
   ignition::rendering::ScenePtr scene;
   ignition::rendering::VisualPtr rootVisual;
-  std::mutex lock;
-  geometry_msgs::msg::PoseArray::SharedPtr msg;
+  std::recursive_mutex lock;
+  geometry_msgs::msg::PoseArray::ConstSharedPtr msg;
+
+  // Message or properties changed since the last upload
+  bool dataChanged{false};
+
   QStringList topicList;
   bool dirty;
   bool visualShape;  // True: Arrow; False: Axis
@@ -112,7 +112,7 @@ public:
   void initialize(rclcpp::Node::SharedPtr _node) override;
 
   // Documentation Inherited
-  void callback(const geometry_msgs::msg::PoseStamped::SharedPtr _msg) override;
+  void callback(const geometry_msgs::msg::PoseStamped::ConstSharedPtr _msg) override;
 
   // Documentation inherited
   void setTopic(const std::string & topic_name) override;
@@ -219,8 +219,8 @@ private:
   ignition::rendering::RenderEngine * engine;
   ignition::rendering::ScenePtr scene;
   ignition::rendering::VisualPtr rootVisual;
-  std::mutex lock;
-  geometry_msgs::msg::PoseStamped::SharedPtr msg;
+  std::recursive_mutex lock;
+  geometry_msgs::msg::PoseStamped::ConstSharedPtr msg;
   QStringList topicList;
   AxisVisualPrivate axis;
   ArrowVisualPrivate arrow;
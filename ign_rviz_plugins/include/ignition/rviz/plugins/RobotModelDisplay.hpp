@@ -132,7 +132,7 @@ public:
   void initialize(rclcpp::Node::SharedPtr _node) override;
 
   // Documentation inherited
-  void callback(const std_msgs::msg::String::SharedPtr _msg) override;
+  void callback(const std_msgs::msg::String::ConstSharedPtr _msg) override;
 
   // Documentation inherited
   void setTopic(const std::string & topic_name) override;
@@ -284,7 +284,7 @@ private:
   ignition::rendering::ScenePtr scene;
   ignition::rendering::VisualPtr rootVisual;
   std::map<std::string, RobotLinkProperties> robotVisualLinks;
-  std_msgs::msg::String::SharedPtr msg;
+  std_msgs::msg::String::ConstSharedPtr msg;
   QStringList topicList;
   urdf::Model robotModel;
   bool modelLoaded;
@@ -202,7 +202,7 @@ private:
   ignition::rendering::RenderEngine * engine;
   ignition::rendering::ScenePtr scene;
   ignition::rendering::VisualPtr tfRootVisual;
-  std::mutex lock;
+  std::recursive_mutex lock;
   bool axesVisible;
   bool arrowsVisible;
   bool namesVisible;
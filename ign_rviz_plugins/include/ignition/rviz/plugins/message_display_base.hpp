@@ -18,8 +18,20 @@
 #include <rclcpp/rclcpp.hpp>
 #include <rclcpp/qos.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #ifndef Q_MOC_RUN
   #include <ignition/gui/qt.h>
@@ -28,6 +40,9 @@
 #include <ignition/gui/MainWindow.hh>
 
 #include "ignition/rviz/common/frame_manager.hpp"
+#include "ignition/rviz/common/render_budget.hpp"
+#include "ignition/rviz/common/topic_cache.hpp"
+#include "ignition/rviz/common/worker_pool.hpp"
 
 namespace ignition
 {
@@ -38,6 +53,18 @@ namespace rviz
  */
 namespace plugins
 {
+namespace detail
+{
+/**
+ * @brief Checks if a message type has a std_msgs/Header
+ */
+template<typename T, typename = void>
+struct HasHeader : std::false_type {};
+
+template<typename T>
+struct HasHeader<T, decltype(void(std::declval<const T &>().header.stamp))>: std::true_type {};
+}  // namespace detail
+
 /**
  * @brief Base class for all display plugins
  */
@@ -45,9 +72,51 @@ class MessageDisplayBase : public gui::Plugin
 {
   Q_OBJECT
 
+  /**
+   * @brief Received messages per second
+   */
+  Q_PROPERTY(double messageRate READ getMessageRate NOTIFY statisticsChanged)
+
+  /**
+   * @brief Average time from header stamp to reception in milliseconds, NaN if unknown
+   */
+  Q_PROPERTY(double stampLatency READ getStampLatency NOTIFY statisticsChanged)
+
+  /**
+   * @brief Average time from reception to render in milliseconds, NaN if unknown
+   */
+  Q_PROPERTY(double renderLatency READ getRenderLatency NOTIFY statisticsChanged)
+
+  /**
+   * @brief Messages replaced before they were rendered
+   */
+  Q_PROPERTY(qulonglong droppedMessages READ getDroppedMessages NOTIFY statisticsChanged)
+
 public:
+  /**
+   * @brief When received messages are rendered
+   */
+  enum class UpdatePolicy
+  {
+    /// Render the latest message and upload it again on every frame
+    Always,
+    /// Upload only when a new message is received
+    OnNewData,
+    /// Take new messages at most at a given rate in Hz
+    MaxRate,
+    /// Render only every Nth received message
+    EveryNth
+  };
+
   MessageDisplayBase()
-  : Plugin() {}
+  : Plugin(), receivedCount(0), droppedCount(0), messageRate(0.0),
+    stampLatency(std::numeric_limits<double>::quiet_NaN()),
+    renderLatency(std::numeric_limits<double>::quiet_NaN()), sampleTime(0), sampleCount(0),
+    notifiedValues{{0.0, std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(), 0.0}},
+    updatePolicy(UpdatePolicy::OnNewData), updatePolicyValue(0.0), decimationCount(0),
+    lastTakeTime(0), priority(common::RenderBudget::Priority::Normal), skippedFrames(0),
+    updateStart(0) {}
 
   /**
    * @brief Initialization function for visualization plugins
@@ -62,11 +131,430 @@ public:
    */
   virtual void setFrameManager(std::shared_ptr<common::FrameManager>) {}
 
+  /**
+   * @brief Set pool used to prepare messages for rendering
+   * @param[in] _workerPool: Shared pointer to WorkerPool object
+   */
+  virtual void setWorkerPool(std::shared_ptr<common::WorkerPool>) {}
+
+  /**
+   * @brief Set topic discovery cache shared by all displays
+   * @param[in] _topicCache: Shared pointer to TopicCache object
+   */
+  void setTopicCache(std::shared_ptr<common::TopicCache> _topicCache)
+  {
+    this->topicCache = std::move(_topicCache);
+  }
+
+  /**
+   * @brief Set frame budget shared by all displays
+   * @param[in] _renderBudget: Shared pointer to RenderBudget object
+   */
+  void setRenderBudget(std::shared_ptr<common::RenderBudget> _renderBudget)
+  {
+    this->renderBudget = std::move(_renderBudget);
+  }
+
+  /**
+   * @brief Set update priority within the frame budget
+   * @param[in] _priority: Display priority
+   */
+  void setPriority(common::RenderBudget::Priority _priority)
+  {
+    this->priority = _priority;
+  }
+
+  /**
+   * @brief Set update priority through GUI
+   * @param[in] _priority: Index of selected priority, from low to high
+   */
+  Q_INVOKABLE void setPriority(const int & _priority)
+  {
+    switch (_priority) {
+      case 0: this->setPriority(common::RenderBudget::Priority::Low);
+        break;
+      case 1: this->setPriority(common::RenderBudget::Priority::Normal);
+        break;
+      case 2: this->setPriority(common::RenderBudget::Priority::High);
+        break;
+    }
+  }
+
+  /**
+   * @brief Set update policy
+   * @param[in] _policy: Update policy
+   * @param[in] _value: Rate in Hz for MaxRate, N for EveryNth, ignored otherwise
+   */
+  void setUpdatePolicy(UpdatePolicy _policy, double _value = 0.0)
+  {
+    this->updatePolicyValue = _value;
+    this->updatePolicy = _policy;
+  }
+
+  /**
+   * @brief Set update policy through GUI
+   * @param[in] _policy: Index of selected update policy
+   * @param[in] _value: Rate in Hz for max rate, N for every Nth message
+   */
+  Q_INVOKABLE void setUpdatePolicy(const int & _policy, const double & _value)
+  {
+    switch (_policy) {
+      case 0: this->setUpdatePolicy(UpdatePolicy::Always);
+        break;
+      case 1: this->setUpdatePolicy(UpdatePolicy::OnNewData);
+        break;
+      case 2: this->setUpdatePolicy(UpdatePolicy::MaxRate, _value);
+        break;
+      case 3: this->setUpdatePolicy(UpdatePolicy::EveryNth, _value);
+        break;
+    }
+  }
+
+  /**
+   * @brief Set ROS subscriber topic
+   * @param[in] topic_name: ROS topic name
+   */
+  virtual void setTopic(const std::string &) {}
+
+  /**
+   * @brief Get subscribed topic
+   * @return Topic name, empty if the display does not subscribe to a topic
+   */
+  virtual std::string getTopicName() const
+  {
+    return "";
+  }
+
+  /**
+   * @brief Get received messages per second
+   * @return Message rate in Hz
+   */
+  double getMessageRate() const
+  {
+    return this->messageRate;
+  }
+
+  /**
+   * @brief Get average time from header stamp to reception
+   * @return Latency in milliseconds, NaN if messages have no stamp
+   */
+  double getStampLatency() const
+  {
+    return this->stampLatency;
+  }
+
+  /**
+   * @brief Get average time from reception to render
+   * @return Latency in milliseconds, NaN if no message was rendered
+   */
+  double getRenderLatency() const
+  {
+    return this->renderLatency;
+  }
+
+  /**
+   * @brief Get number of messages replaced before they were rendered
+   * @return Dropped messages
+   */
+  qulonglong getDroppedMessages() const
+  {
+    return this->droppedCount;
+  }
+
+signals:
+  /**
+   * @brief Notify that message statistics have been updated
+   */
+  void statisticsChanged();
+
+protected:
+  /**
+   * @brief Record reception of a message. Called from the subscriber callback.
+   * @param[in] _stampLatency: Time from header stamp to reception in milliseconds,
+   * NaN if unknown
+   * @return Reception time in nanoseconds of the steady clock
+   */
+  int64_t recordReceive(double _stampLatency)
+  {
+    this->receivedCount++;
+
+    if (!std::isnan(_stampLatency)) {
+      this->stampLatency = smooth(this->stampLatency, _stampLatency);
+    }
+    return steadyTime();
+  }
+
+  /**
+   * @brief Record render of a received message
+   * @param[in] _receiveTime: Reception time of the rendered message, as returned by
+   * recordReceive
+   */
+  void recordRender(int64_t _receiveTime)
+  {
+    const double latency = (steadyTime() - _receiveTime) / 1e6;
+    this->renderLatency = smooth(this->renderLatency, latency);
+  }
+
+  /**
+   * @brief Update message rate, at most once per second like the diagnostics, and
+   * notify listeners if any statistic changed. Must always be called from the same thread.
+   * @param[in] _dropped: Number of dropped messages
+   */
+  void sampleStatistics(uint64_t _dropped)
+  {
+    const int64_t now = steadyTime();
+    const int64_t elapsed = now - this->sampleTime;
+    if (elapsed < 1000000000) {
+      return;
+    }
+
+    const uint64_t received = this->receivedCount;
+    this->messageRate = (this->sampleTime == 0) ? 0.0 :
+      (received - this->sampleCount) * 1e9 / elapsed;
+    this->droppedCount = _dropped;
+    this->sampleTime = now;
+    this->sampleCount = received;
+
+    // QML bindings of every display card are evaluated on each notification
+    const std::array<double, 4> values = {
+      this->messageRate, this->stampLatency, this->renderLatency,
+      static_cast<double>(_dropped)};
+    bool changed = false;
+    for (size_t i = 0; i < values.size(); ++i) {
+      const bool bothNaN = std::isnan(values[i]) && std::isnan(this->notifiedValues[i]);
+      changed |= !bothNaN && values[i] != this->notifiedValues[i];
+    }
+    if (!changed) {
+      return;
+    }
+    this->notifiedValues = values;
+
+    emit statisticsChanged();
+  }
+
+  /**
+   * @brief Apply every Nth message decimation. Called from the subscriber callback.
+   * @return True if the received message should be rendered
+   */
+  bool acceptMessage()
+  {
+    if (this->updatePolicy != UpdatePolicy::EveryNth) {
+      return true;
+    }
+
+    const uint64_t n = static_cast<uint64_t>(std::max(1.0, this->updatePolicyValue.load()));
+    return this->decimationCount++ % n == 0;
+  }
+
+  /**
+   * @brief Apply max rate throttling. Called on the render thread.
+   * @return True if a new message can be taken in this frame
+   */
+  bool takeAllowed() const
+  {
+    const double rate = this->updatePolicyValue;
+    if (this->updatePolicy != UpdatePolicy::MaxRate || rate <= 0.0) {
+      return true;
+    }
+
+    return steadyTime() - this->lastTakeTime >= 1e9 / rate;
+  }
+
+  /**
+   * @brief Record that a new message was taken for rendering
+   */
+  void recordTake()
+  {
+    this->lastTakeTime = steadyTime();
+  }
+
+  /**
+   * @brief Check if geometry must be uploaded in this frame
+   * @param[in] _changed: True if a new message was taken or display properties changed
+   * @return True if geometry must be uploaded
+   */
+  bool uploadRequired(bool _changed) const
+  {
+    return _changed || this->updatePolicy == UpdatePolicy::Always;
+  }
+
+  /**
+   * @brief Acquire the frame budget before updating. Called on every render event.
+   * @return True if the display should update, false to skip this frame
+   */
+  bool beginUpdate()
+  {
+    if (!this->renderBudget) {
+      return true;
+    }
+
+    if (!this->renderBudget->acquire(this->priority, this->skippedFrames)) {
+      this->skippedFrames++;
+      return false;
+    }
+
+    this->skippedFrames = 0;
+    this->updateStart = steadyTime();
+    return true;
+  }
+
+  /**
+   * @brief Release the frame budget after an update started with beginUpdate
+   */
+  void endUpdate()
+  {
+    if (this->renderBudget) {
+      this->renderBudget->release(std::chrono::nanoseconds(steadyTime() - this->updateStart));
+    }
+  }
+
+private:
+  /**
+   * @brief Get steady clock time in nanoseconds
+   */
+  static int64_t steadyTime()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  /**
+   * @brief Exponential moving average of latency samples
+   */
+  static double smooth(double _average, double _sample)
+  {
+    return std::isnan(_average) ? _sample : 0.9 * _average + 0.1 * _sample;
+  }
+
 protected:
   /**
    * @brief Reference to FrameManager
    */
   std::shared_ptr<common::FrameManager> frameManager;
+
+  /**
+   * @brief Reference to TopicCache
+   */
+  std::shared_ptr<common::TopicCache> topicCache;
+
+private:
+  // Message statistics, written by the subscriber and render threads
+  std::atomic<uint64_t> receivedCount;
+  std::atomic<uint64_t> droppedCount;
+  std::atomic<double> messageRate;
+  std::atomic<double> stampLatency;
+  std::atomic<double> renderLatency;
+
+  // Rate sampling state, owned by the thread calling sampleStatistics
+  int64_t sampleTime;
+  uint64_t sampleCount;
+  std::array<double, 4> notifiedValues;
+
+  // Update policy, set from the GUI and read by the subscriber and render threads
+  std::atomic<UpdatePolicy> updatePolicy;
+  std::atomic<double> updatePolicyValue;
+  std::atomic<uint64_t> decimationCount;
+
+  // Render state, owned by the render thread
+  int64_t lastTakeTime;
+  std::shared_ptr<common::RenderBudget> renderBudget;
+  common::RenderBudget::Priority priority;
+  unsigned int skippedFrames;
+  int64_t updateStart;
+};
+
+/**
+ * @brief Lock-free single slot holding the latest unread message
+ *
+ * The subscriber posts messages and the render thread takes them, neither
+ * side ever blocks the other. A message replaced before it was taken is
+ * counted as dropped. Messages are stored with their reception time, so
+ * latency is measured for the message actually rendered.
+ *
+ * @tparam MessageType ROS2 message type
+ */
+template<typename MessageType>
+class MessageMailbox
+{
+public:
+  using MessagePtr = typename MessageType::ConstSharedPtr;
+
+  MessageMailbox()
+  : postedCount(0), droppedCount(0) {}
+
+  /**
+   * @brief Store a message, replacing the unread one if any
+   * @param[in] _msg: Received message
+   * @param[in] _receiveTime: Reception time of the message
+   */
+  void post(MessagePtr _msg, int64_t _receiveTime)
+  {
+    auto letter = std::make_shared<const Letter>(Letter{std::move(_msg), _receiveTime});
+    LetterPtr previous = std::atomic_exchange(&this->slot, std::move(letter));
+    this->postedCount++;
+    if (previous) {
+      this->droppedCount++;
+    }
+  }
+
+  /**
+   * @brief Take the latest unread message
+   * @param[out] _receiveTime: Reception time of the taken message, unchanged if none
+   * @return Latest message, or nullptr if no message was posted since the last call
+   */
+  MessagePtr take(int64_t * _receiveTime = nullptr)
+  {
+    LetterPtr letter = std::atomic_exchange(&this->slot, LetterPtr());
+    if (!letter) {
+      return MessagePtr();
+    }
+    if (_receiveTime) {
+      *_receiveTime = letter->receiveTime;
+    }
+    return letter->msg;
+  }
+
+  /**
+   * @brief Discard the unread message
+   */
+  void clear()
+  {
+    this->take();
+  }
+
+  /**
+   * @brief Get number of posted messages
+   * @return Number of messages posted since construction
+   */
+  uint64_t posted() const
+  {
+    return this->postedCount;
+  }
+
+  /**
+   * @brief Get number of dropped messages
+   * @return Number of messages replaced before they were taken
+   */
+  uint64_t dropped() const
+  {
+    return this->droppedCount;
+  }
+
+private:
+  /**
+   * @brief Message with its reception time
+   */
+  struct Letter
+  {
+    MessagePtr msg;
+    int64_t receiveTime;
+  };
+  using LetterPtr = std::shared_ptr<const Letter>;
+
+  // Accessed only through std::atomic_exchange
+  LetterPtr slot;
+  std::atomic<uint64_t> postedCount;
+  std::atomic<uint64_t> droppedCount;
 };
 
 /**
@@ -80,7 +568,8 @@ class MessageDisplay : public MessageDisplayBase
 
 public:
   MessageDisplay()
-  : MessageDisplayBase(), qos(5)
+  : MessageDisplayBase(), qos(5),
+    callbackGroupType(rclcpp::CallbackGroupType::MutuallyExclusive)
   {
     qos = qos.history(RMW_QOS_POLICY_HISTORY_KEEP_LAST);
     qos = qos.reliability(RMW_QOS_POLICY_RELIABILITY_RELIABLE);
@@ -91,16 +580,20 @@ public:
 
   /**
    * @brief ROS subscriber callback function
+   *
+   * Messages are received as shared pointers to const, so intra-process
+   * publishers can hand over messages without copying them.
+   *
    * @param[in] _msg: ROS message type shared pointer
    * @throws anything rclcpp::exceptions::throw_from_rcl_error can throw.
    */
-  virtual void callback(const typename MessageType::SharedPtr) {}
+  virtual void callback(const typename MessageType::ConstSharedPtr) {}
 
-  /**
-   * @brief Set ROS subscriber topic
-   * @param[in] topic_name: ROS topic name
-   */
-  virtual void setTopic(const std::string &) {}
+  // Documentation inherited
+  std::string getTopicName() const override
+  {
+    return this->topic_name;
+  }
 
 protected:
   /**
@@ -128,6 +621,135 @@ protected:
    */
   virtual void update() {}
 
+  /**
+   * @brief Record statistics of a received message and post it to the mailbox
+   * @param[in] _msg: Received message
+   */
+  virtual void receive(typename MessageType::ConstSharedPtr _msg)
+  {
+    const int64_t receiveTime = this->recordReceive(this->stampLatencyOf(*_msg));
+    if (this->acceptMessage()) {
+      this->mailbox.post(std::move(_msg), receiveTime);
+    }
+  }
+
+  /**
+   * @brief Take the latest received message from the mailbox. Called on every render event.
+   * @return Latest message, or nullptr if no message was received since the last call
+   */
+  typename MessageType::ConstSharedPtr takeLatest()
+  {
+    typename MessageType::ConstSharedPtr latest;
+    int64_t receiveTime = 0;
+    if (this->takeAllowed()) {
+      latest = this->mailbox.take(&receiveTime);
+    }
+    if (latest) {
+      this->recordRender(receiveTime);
+      this->recordTake();
+    }
+    this->sampleStatistics(this->mailbox.dropped());
+
+    return latest;
+  }
+
+  /**
+   * @brief Get topics of a message type, from the topic cache if set
+   * @param[in] _type: Message type, e.g. "sensor_msgs/msg/LaserScan"
+   * @return Topic names in alphabetical order
+   */
+  std::vector<std::string> getTopicsByType(const std::string & _type) const
+  {
+    if (this->topicCache) {
+      return this->topicCache->getTopics(_type);
+    }
+
+    // Without cache, query the graph directly
+    std::vector<std::string> topics;
+    for (const auto & topic : this->node->get_topic_names_and_types()) {
+      if (std::find(topic.second.begin(), topic.second.end(), _type) != topic.second.end()) {
+        topics.push_back(topic.first);
+      }
+    }
+    return topics;
+  }
+
+  /**
+   * @brief Get time from header stamp to now
+   * @param[in] _msg: Message with header
+   * @return Latency in milliseconds, NaN if the stamp is not set
+   */
+  template<typename T = MessageType>
+  typename std::enable_if<detail::HasHeader<T>::value, double>::type
+  stampLatencyOf(const T & _msg) const
+  {
+    const rclcpp::Time stamp(_msg.header.stamp, this->node->get_clock()->get_clock_type());
+    if (stamp.nanoseconds() == 0) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    return (this->node->now() - stamp).seconds() * 1000.0;
+  }
+
+  /**
+   * @brief Messages without header have no stamp latency
+   * @return NaN
+   */
+  template<typename T = MessageType>
+  typename std::enable_if<!detail::HasHeader<T>::value, double>::type
+  stampLatencyOf(const T &) const
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  /**
+   * @brief Get subscription options for the current QoS profile
+   *
+   * Every display has its own callback group, so a slow display does not
+   * block other displays or tf on the multi-threaded executor.
+   *
+   * Intra-process communication is enabled through the node options. It only
+   * supports volatile durability and keep last history with a non-zero depth,
+   * and is disabled for the subscription otherwise.
+   *
+   * @return Subscription options
+   */
+  rclcpp::SubscriptionOptions subscriptionOptions()
+  {
+    if (!this->callbackGroup) {
+      this->callbackGroup = this->node->create_callback_group(this->callbackGroupType);
+    }
+
+    rclcpp::SubscriptionOptions options;
+    options.callback_group = this->callbackGroup;
+
+    // rclcpp rejects intra-process subscriptions with any other policies,
+    // system default included
+    const rmw_qos_profile_t & profile = this->qos.get_rmw_qos_profile();
+    if (profile.history != RMW_QOS_POLICY_HISTORY_KEEP_LAST ||
+      profile.durability != RMW_QOS_POLICY_DURABILITY_VOLATILE || profile.depth == 0)
+    {
+      options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    }
+
+    return options;
+  }
+
+  /**
+   * @brief Set type of the display callback group. Takes effect on the next subscription.
+   *
+   * Reentrant groups let consecutive messages be processed in parallel,
+   * the callback must then be thread-safe.
+   *
+   * @param[in] _type: Callback group type
+   */
+  void setCallbackGroupType(rclcpp::CallbackGroupType _type)
+  {
+    if (_type != this->callbackGroupType) {
+      this->callbackGroupType = _type;
+      this->callbackGroup.reset();
+    }
+  }
+
   /**
    * @brief Set history depth for keep last history QoS policy
    * @param _depth History depth
@@ -190,6 +812,188 @@ protected:
   rclcpp::Node::SharedPtr node;
   rclcpp::QoS qos;
   std::string topic_name;
+  MessageMailbox<MessageType> mailbox;
+  rclcpp::CallbackGroup::SharedPtr callbackGroup;
+  rclcpp::CallbackGroupType callbackGroupType;
+};
+
+/**
+ * @brief Base class for displays converting messages before rendering
+ *
+ * Messages are converted by prepare() on a worker pool into render-ready
+ * data, so the render thread only uploads the result. At most one message
+ * per display is prepared at a time, messages received meanwhile replace
+ * each other in the mailbox and only the latest is prepared next.
+ *
+ * Without worker pool, messages are prepared on the subscriber thread.
+ *
+ * @tparam MessageType ROS2 message type
+ * @tparam PreparedType Render-ready data produced from a message
+ */
+template<typename MessageType, typename PreparedType>
+class PreparedMessageDisplay : public MessageDisplay<MessageType>
+{
+  // No Q_OBJECT macro here, moc does not support Q_OBJECT in a templated class.
+
+public:
+  using PreparedPtr = std::shared_ptr<const PreparedType>;
+
+  PreparedMessageDisplay()
+  : MessageDisplay<MessageType>(), generation(0), preparedDropped(0),
+    preparing(false), pending(false), stopped(false) {}
+
+  virtual ~PreparedMessageDisplay()
+  {
+    this->stopPreparing();
+  }
+
+  // Documentation inherited
+  void setWorkerPool(std::shared_ptr<common::WorkerPool> _workerPool) override
+  {
+    std::lock_guard<std::mutex> guard(this->prepareMutex);
+    this->workerPool = std::move(_workerPool);
+  }
+
+protected:
+  /**
+   * @brief Convert a message into render-ready data. Called on a worker thread,
+   * must not access the render engine or state used by the render thread.
+   * @param[in] _msg: Received message
+   * @return Render-ready data, or nullptr if the message cannot be displayed
+   */
+  virtual PreparedPtr prepare(const MessageType & _msg) = 0;
+
+  /**
+   * @brief Notify that new prepared data is available. Called on a worker thread.
+   * Displays not driven by render events override this to schedule an update.
+   */
+  virtual void onPrepared() {}
+
+  // Documentation inherited
+  void receive(typename MessageType::ConstSharedPtr _msg) override
+  {
+    MessageDisplay<MessageType>::receive(std::move(_msg));
+
+    std::unique_lock<std::mutex> guard(this->prepareMutex);
+    if (this->stopped) {
+      return;
+    }
+    if (this->preparing) {
+      // Picked up by the running task
+      this->pending = true;
+      return;
+    }
+    this->preparing = true;
+
+    if (this->workerPool) {
+      this->workerPool->post([this]() {this->prepareLatest();});
+    } else {
+      guard.unlock();
+      this->prepareLatest();
+    }
+  }
+
+  /**
+   * @brief Take the latest prepared data. Called on every render event.
+   * @return Latest prepared data, or nullptr if nothing was prepared since the last call
+   */
+  PreparedPtr takePrepared()
+  {
+    PreparedSlotPtr latest;
+    if (this->takeAllowed()) {
+      latest = std::atomic_exchange(&this->prepared, PreparedSlotPtr());
+    }
+    if (latest) {
+      this->recordRender(latest->receiveTime);
+      this->recordTake();
+    }
+    this->sampleStatistics(this->mailbox.dropped() + this->preparedDropped);
+
+    return latest ? latest->data : PreparedPtr();
+  }
+
+  /**
+   * @brief Discard received and prepared data. Data being prepared is discarded on completion.
+   */
+  void clearPrepared()
+  {
+    std::lock_guard<std::mutex> guard(this->prepareMutex);
+    this->generation++;
+    this->mailbox.clear();
+    std::atomic_exchange(&this->prepared, PreparedSlotPtr());
+  }
+
+  /**
+   * @brief Stop preparing messages and wait for the running task.
+   * Must be called in the destructor of classes implementing prepare().
+   */
+  void stopPreparing()
+  {
+    std::unique_lock<std::mutex> guard(this->prepareMutex);
+    this->stopped = true;
+    this->prepareDone.wait(
+      guard, [this]() {
+        return !this->preparing;
+      });
+  }
+
+private:
+  /**
+   * @brief Prepare messages until the mailbox is empty
+   */
+  void prepareLatest()
+  {
+    while (true) {
+      const uint64_t taken = this->generation;
+      int64_t receiveTime = 0;
+      auto msg = this->mailbox.take(&receiveTime);
+      PreparedPtr data = msg ? this->prepare(*msg) : PreparedPtr();
+
+      std::lock_guard<std::mutex> guard(this->prepareMutex);
+
+      // Discard data prepared before the display was reset
+      if (data && taken == this->generation) {
+        auto slot =
+          std::make_shared<const PreparedSlot>(PreparedSlot{std::move(data), receiveTime});
+        if (std::atomic_exchange(&this->prepared, std::move(slot))) {
+          this->preparedDropped++;
+        }
+        this->onPrepared();
+      }
+
+      if (!this->pending || this->stopped) {
+        this->preparing = false;
+        this->prepareDone.notify_all();
+        return;
+      }
+      this->pending = false;
+    }
+  }
+
+private:
+  /**
+   * @brief Prepared data with the reception time of its message
+   */
+  struct PreparedSlot
+  {
+    PreparedPtr data;
+    int64_t receiveTime;
+  };
+  using PreparedSlotPtr = std::shared_ptr<const PreparedSlot>;
+
+  // Accessed only through std::atomic_exchange
+  PreparedSlotPtr prepared;
+
+  std::shared_ptr<common::WorkerPool> workerPool;
+  std::atomic<uint64_t> generation;
+  std::atomic<uint64_t> preparedDropped;
+
+  // Guards the preparation state below
+  std::mutex prepareMutex;
+  std::condition_variable prepareDone;
+  bool preparing;
+  bool pending;
+  bool stopped;
 };
 
 }  // namespace plugins
@@ -21,6 +21,7 @@ import QtQuick.Controls.Material 2.1
 import QtLocation 5.6
 import QtPositioning 5.6
 import "qrc:/QoSConfig"
+import "qrc:/MessageStatistics"
 
 Item {
   property double lat: 0.0
@@ -90,6 +91,10 @@ Item {
       }
     }
 
+    MessageStatistics {
+      display: GPSDisplay
+    }
+
     RowLayout {
       width: parent.width
 
@@ -19,6 +19,7 @@ import QtQuick.Controls 2.2
 import QtQuick.Layouts 1.3
 import QtQuick.Controls.Material 2.1
 import "qrc:/QoSConfig"
+import "qrc:/MessageStatistics"
 
 Item {
   Layout.minimumWidth: 280
@@ -97,9 +98,15 @@ Item {
     }
   }
 
+  MessageStatistics {
+    id: statistics
+    anchors.top: qos.bottom
+    display: ImageDisplay
+  }
+
   Image {
     id: image
-    anchors.top: qos.bottom
+    anchors.top: statistics.bottom
     anchors.bottom: parent.bottom
     anchors.left: parent.left
     anchors.right: parent.right
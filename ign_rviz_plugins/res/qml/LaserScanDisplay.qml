@@ -19,6 +19,7 @@ import QtQuick.Controls 2.2
 import QtQuick.Layouts 1.3
 import QtQuick.Controls.Material 2.1
 import "qrc:/QoSConfig"
+import "qrc:/MessageStatistics"
 
 Item {
   Layout.minimumWidth: 250
@@ -74,6 +75,10 @@ Item {
       }
     }
 
+    MessageStatistics {
+      display: LaserScanDisplay
+    }
+
     RowLayout {
       width: parent.width
 
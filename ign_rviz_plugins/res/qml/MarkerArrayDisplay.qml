@@ -20,6 +20,7 @@ import QtQuick.Layouts 1.3
 import QtQuick.Controls.Material 2.1
 import QtQuick.Dialogs 1.0
 import "qrc:/QoSConfig"
+import "qrc:/MessageStatistics"
 
 Item {
   Layout.minimumWidth: 250
@@ -74,5 +75,9 @@ Item {
         MarkerArrayDisplay.updateQoS(depth, history, reliability, durability)
       }
     }
+
+    MessageStatistics {
+      display: MarkerArrayDisplay
+    }
   }
 }
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.2
+import QtQuick.Layouts 1.3
+import QtQuick.Controls.Material 2.1
+
+ColumnLayout {
+  id: messageStatistics
+  // Display plugin providing the statistics properties
+  property var display
+
+  width: parent.width
+  Layout.fillWidth: true
+
+  function formatLatency(latency) {
+    return isNaN(latency) ? "-" : latency.toFixed(1) + " ms"
+  }
+
+  RoundButton {
+    Layout.fillWidth: true
+    Layout.preferredHeight: 30
+    text: (statisticsColumn.visible ? "\u25B4" : "\u25BE") + " Statistics"
+    Material.background: "#fafafa"
+    onClicked: {
+      statisticsColumn.visible = !statisticsColumn.visible;
+    }
+  }
+
+  GridLayout {
+    id: statisticsColumn
+    Layout.fillWidth: true
+    columns: 2
+    visible: false
+
+    Text {
+      Layout.minimumWidth: 110
+      text: "Message Rate"
+      font.pointSize: 10.5
+    }
+
+    Text {
+      Layout.fillWidth: true
+      text: display ? display.messageRate.toFixed(1) + " Hz" : "-"
+      font.pointSize: 10.5
+    }
+
+    Text {
+      Layout.minimumWidth: 110
+      text: "Stamp Latency"
+      font.pointSize: 10.5
+    }
+
+    Text {
+      Layout.fillWidth: true
+      text: display ? formatLatency(display.stampLatency) : "-"
+      font.pointSize: 10.5
+    }
+
+    Text {
+      Layout.minimumWidth: 110
+      text: "Render Latency"
+      font.pointSize: 10.5
+    }
+
+    Text {
+      Layout.fillWidth: true
+      text: display ? formatLatency(display.renderLatency) : "-"
+      font.pointSize: 10.5
+    }
+
+    Text {
+      Layout.minimumWidth: 110
+      text: "Dropped"
+      font.pointSize: 10.5
+    }
+
+    Text {
+      Layout.fillWidth: true
+      text: display ? display.droppedMessages : "-"
+      font.pointSize: 10.5
+    }
+  }
+}
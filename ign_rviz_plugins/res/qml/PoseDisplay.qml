@@ -20,6 +20,7 @@ import QtQuick.Layouts 1.3
 import QtQuick.Controls.Material 2.1
 import QtQuick.Dialogs 1.0
 import "qrc:/QoSConfig"
+import "qrc:/MessageStatistics"
 
 Item {
   Layout.minimumWidth: 250
@@ -75,6 +76,10 @@ Item {
       }
     }
 
+    MessageStatistics {
+      display: PoseDisplay
+    }
+
     RowLayout {
       width: parent.width
 
@@ -22,6 +22,7 @@ import QtQuick.Controls.Styles 1.4
 import QtQuick.Controls.Material 2.1
 import QtQuick.Layouts 1.3
 import QtQuick.Dialogs 1.0
+import "qrc:/MessageStatistics"
 
 Item {
   // Tree Properties
@@ -153,6 +154,11 @@ Item {
       }
     }
 
+    MessageStatistics {
+      visible: sourceCombo.currentIndex === 0
+      display: RobotModelDisplay
+    }
+
     RowLayout {
       visible: sourceCombo.currentIndex === 1
       width: parent.width
@@ -68,7 +68,7 @@ bool AxesDisplay::eventFilter(QObject * object, QEvent * event)
     }
     // Update pose
     {
-      std::lock_guard(this->lock);
+      std::lock_guard<std::mutex> guard(this->lock);
 
       // Origin pose. Fixed Frame always at origin.
       math::Pose3d pose;
@@ -97,14 +97,14 @@ bool AxesDisplay::eventFilter(QObject * object, QEvent * event)
 ////////////////////////////////////////////////////////////////////////////////
 void AxesDisplay::setFrame(const QString & frame)
 {
-  std::lock_guard(this->lock);
+  std::lock_guard<std::mutex> guard(this->lock);
   this->frame = frame.toStdString();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void AxesDisplay::setLength(const float & length)
 {
-  std::lock_guard(this->lock);
+  std::lock_guard<std::mutex> guard(this->lock);
   if (!isnan(length)) {
     this->length = length;
     this->dirty = true;
@@ -114,7 +114,7 @@ void AxesDisplay::setLength(const float & length)
 ////////////////////////////////////////////////////////////////////////////////
 void AxesDisplay::setRadius(const float & radius)
 {
-  std::lock_guard(this->lock);
+  std::lock_guard<std::mutex> guard(this->lock);
   if (!isnan(radius)) {
     this->radius = radius;
     this->dirty = true;
@@ -124,7 +124,7 @@ void AxesDisplay::setRadius(const float & radius)
 ////////////////////////////////////////////////////////////////////////////////
 void AxesDisplay::setHeadVisibility(const bool & visible)
 {
-  std::lock_guard(this->lock);
+  std::lock_guard<std::mutex> guard(this->lock);
   if (!isnan(radius)) {
     this->headVisible = visible;
     this->dirty = true;
@@ -134,7 +134,7 @@ void AxesDisplay::setHeadVisibility(const bool & visible)
 ////////////////////////////////////////////////////////////////////////////////
 AxesDisplay::~AxesDisplay()
 {
-  std::lock_guard(this->lock);
+  std::lock_guard<std::mutex> guard(this->lock);
   // Delete visual
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->removeEventFilter(this);
   this->scene->DestroyVisual(this->rootVisual);
@@ -143,7 +143,7 @@ AxesDisplay::~AxesDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 void AxesDisplay::setFrameManager(std::shared_ptr<common::FrameManager> _frameManager)
 {
-  std::lock_guard(this->lock);
+  std::lock_guard<std::mutex> guard(this->lock);
   this->frameManager = std::move(_frameManager);
   this->frame = this->frameManager->getFixedFrame();
 
@@ -30,25 +30,26 @@ namespace plugins
 ////////////////////////////////////////////////////////////////////////////////
 void GPSDisplay::initialize(rclcpp::Node::SharedPtr _node)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->node = std::move(_node);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void GPSDisplay::subscribe()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   this->subscriber = this->node->create_subscription<sensor_msgs::msg::NavSatFix>(
     this->topic_name,
     this->qos,
-    std::bind(&GPSDisplay::callback, this, std::placeholders::_1));
+    std::bind(&GPSDisplay::callback, this, std::placeholders::_1),
+    this->subscriptionOptions());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void GPSDisplay::setTopic(const std::string & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name;
 
   this->subscribe();
@@ -60,7 +61,7 @@ void GPSDisplay::setTopic(const std::string & topic_name)
 ////////////////////////////////////////////////////////////////////////////////
 void GPSDisplay::setTopic(const QString & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name.toStdString();
 
   // Destroy previous subscription
@@ -72,9 +73,11 @@ void GPSDisplay::setTopic(const QString & topic_name)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void GPSDisplay::callback(const sensor_msgs::msg::NavSatFix::SharedPtr _msg)
+void GPSDisplay::callback(const sensor_msgs::msg::NavSatFix::ConstSharedPtr _msg)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  this->recordReceive(this->stampLatencyOf(*_msg));
+  this->sampleStatistics(0);
+
   float covariance = 0;
   if (_msg->position_covariance_type != sensor_msgs::msg::NavSatFix::COVARIANCE_TYPE_UNKNOWN) {
     covariance = std::max(_msg->position_covariance[0], _msg->position_covariance[4]);
@@ -95,7 +98,7 @@ QStringList GPSDisplay::getTopicList() const
 ////////////////////////////////////////////////////////////////////////////////
 void GPSDisplay::onRefresh()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Clear
   this->topicList.clear();
@@ -103,17 +106,12 @@ void GPSDisplay::onRefresh()
   int index = 0, position = 0;
 
   // Get topic list
-  auto topics = this->node->get_topic_names_and_types();
-  for (const auto & topic : topics) {
-    for (const auto & topicType : topic.second) {
-      if (topicType == "sensor_msgs/msg/NavSatFix") {
-        this->topicList.push_back(QString::fromStdString(topic.first));
-        if (topic.first == this->topic_name) {
-          position = index;
-        }
-        index++;
-      }
+  for (const auto & topic : this->getTopicsByType("sensor_msgs/msg/NavSatFix")) {
+    this->topicList.push_back(QString::fromStdString(topic));
+    if (topic == this->topic_name) {
+      position = index;
     }
+    index++;
   }
   // Update combo-box
   this->topicListChanged();
@@ -125,7 +123,7 @@ void GPSDisplay::updateQoS(
   const int & _depth, const int & _history, const int & _reliability,
   const int & _durability)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->setHistoryDepth(_depth);
   this->setHistoryPolicy(_history);
   this->setReliabilityPolicy(_reliability);
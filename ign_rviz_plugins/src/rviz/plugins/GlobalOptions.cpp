@@ -49,14 +49,14 @@ GlobalOptions::GlobalOptions()
 ////////////////////////////////////////////////////////////////////////////////
 void GlobalOptions::setFrame(const QString & _frame)
 {
-  std::lock_guard(this->lock);
+  std::lock_guard<std::mutex> guard(this->lock);
   this->frameManager->setFixedFrame(_frame.toStdString());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void GlobalOptions::setSceneBackground(const QColor & _color)
 {
-  std::lock_guard(this->lock);
+  std::lock_guard<std::mutex> guard(this->lock);
   this->color = _color;
   this->dirty = true;
 }
@@ -64,7 +64,7 @@ void GlobalOptions::setSceneBackground(const QColor & _color)
 ////////////////////////////////////////////////////////////////////////////////
 void GlobalOptions::setFrameManager(std::shared_ptr<common::FrameManager> _frameManager)
 {
-  std::lock_guard(this->lock);
+  std::lock_guard<std::mutex> guard(this->lock);
   this->frameManager = std::move(_frameManager);
   this->frameList.clear();
 
@@ -76,7 +76,7 @@ void GlobalOptions::setFrameManager(std::shared_ptr<common::FrameManager> _frame
 bool GlobalOptions::eventFilter(QObject * _object, QEvent * _event)
 {
   if (_event->type() == gui::events::Render::kType) {
-    std::lock_guard(this->lock);
+    std::lock_guard<std::mutex> guard(this->lock);
     if (!initialized) {
       if (this->scene == nullptr) {
         this->scene = this->engine->SceneByName("scene");
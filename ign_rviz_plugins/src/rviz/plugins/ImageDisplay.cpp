@@ -18,6 +18,7 @@
 #include <ignition/plugin/Register.hh>
 
 #include <limits>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -29,15 +30,18 @@ namespace plugins
 {
 ////////////////////////////////////////////////////////////////////////////////
 ImageDisplay::ImageDisplay()
-: MessageDisplay() {}
+: PreparedMessageDisplay() {}
 
 ////////////////////////////////////////////////////////////////////////////////
-ImageDisplay::~ImageDisplay() {}
+ImageDisplay::~ImageDisplay()
+{
+  this->stopPreparing();
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 void ImageDisplay::initialize(rclcpp::Node::SharedPtr _node)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->node = std::move(_node);
 }
 
@@ -47,13 +51,14 @@ void ImageDisplay::subscribe()
   this->subscriber = this->node->create_subscription<sensor_msgs::msg::Image>(
     this->topic_name,
     this->qos,
-    std::bind(&ImageDisplay::callback, this, std::placeholders::_1));
+    std::bind(&ImageDisplay::callback, this, std::placeholders::_1),
+    this->subscriptionOptions());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void ImageDisplay::setTopic(const std::string & topic_name)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name;
 
   this->subscribe();
@@ -65,7 +70,7 @@ void ImageDisplay::setTopic(const std::string & topic_name)
 ////////////////////////////////////////////////////////////////////////////////
 void ImageDisplay::setTopic(const QString & topic_name)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name.toStdString();
 
   // Destroy previous subscription
@@ -76,62 +81,86 @@ void ImageDisplay::setTopic(const QString & topic_name)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ImageDisplay::callback(const sensor_msgs::msg::Image::SharedPtr _msg)
+void ImageDisplay::callback(const sensor_msgs::msg::Image::ConstSharedPtr _msg)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
   if (!_msg) {
     return;
   }
 
-  this->msg = std::move(_msg);
-
-  if (_msg->encoding == "bgr8") {
-    updateFromBGR8();
-  } else if (_msg->encoding == "rgb8") {
-    updateFromRGB8();
-  } else if (_msg->encoding == "mono8") {
-    updateFromMONO8();
-  } else if (_msg->encoding == "mono16") {
-    updateFromMONO16();
-  } else if (_msg->encoding == "32FC1") {
-    updateFromFloat32();
-  } else {
-    RCLCPP_ERROR(
-      this->node->get_logger(), "Unsupported image encoding: %s",
-      _msg->encoding.c_str());
+  this->receive(_msg);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ImageDisplay::PreparedPtr ImageDisplay::prepare(const sensor_msgs::msg::Image & _msg)
+{
+  if (_msg.encoding == "bgr8") {
+    return std::make_shared<const QImage>(convertFromBGR8(_msg));
+  } else if (_msg.encoding == "rgb8") {
+    return std::make_shared<const QImage>(convertFromRGB8(_msg));
+  } else if (_msg.encoding == "mono8") {
+    return std::make_shared<const QImage>(convertFromMONO8(_msg));
+  } else if (_msg.encoding == "mono16") {
+    return std::make_shared<const QImage>(convertFromMONO16(_msg));
+  } else if (_msg.encoding == "32FC1") {
+    return std::make_shared<const QImage>(convertFromFloat32(_msg));
   }
+
+  RCLCPP_ERROR(
+    this->node->get_logger(), "Unsupported image encoding: %s",
+    _msg.encoding.c_str());
+  return nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ImageDisplay::updateFromBGR8()
+void ImageDisplay::onPrepared()
 {
-  QImage image(&msg->data[0], msg->width, msg->height, msg->step, QImage::Format_RGB888);
-  image = image.rgbSwapped();
-  this->provider->SetImage(image);
-  this->newImage();
+  // Upload on the GUI thread, dropped if the display is destroyed meanwhile
+  QMetaObject::invokeMethod(
+    this, [this]() {
+      this->update();
+    }, Qt::QueuedConnection);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ImageDisplay::updateFromRGB8()
+void ImageDisplay::update()
 {
-  QImage image(&msg->data[0], msg->width, msg->height, msg->step, QImage::Format_RGB888);
-  this->provider->SetImage(image);
+  auto image = this->takePrepared();
+  if (!image) {
+    return;
+  }
+
+  this->provider->SetImage(*image);
   this->newImage();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ImageDisplay::updateFromMONO8()
+QImage ImageDisplay::convertFromBGR8(const sensor_msgs::msg::Image & _msg)
 {
-  QImage image(&msg->data[0], msg->width, msg->height, msg->step, QImage::Format_Grayscale8);
-  this->provider->SetImage(image);
-  this->newImage();
+  QImage image(&_msg.data[0], _msg.width, _msg.height, _msg.step, QImage::Format_RGB888);
+  return image.rgbSwapped();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+QImage ImageDisplay::convertFromRGB8(const sensor_msgs::msg::Image & _msg)
+{
+  // Deep copy, the image must outlive the message buffer
+  QImage image(&_msg.data[0], _msg.width, _msg.height, _msg.step, QImage::Format_RGB888);
+  return image.copy();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ImageDisplay::updateFromMONO16()
+QImage ImageDisplay::convertFromMONO8(const sensor_msgs::msg::Image & _msg)
 {
-  unsigned int height = msg->height;
-  unsigned int width = msg->width;
+  // Deep copy, the image must outlive the message buffer
+  QImage image(&_msg.data[0], _msg.width, _msg.height, _msg.step, QImage::Format_Grayscale8);
+  return image.copy();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+QImage ImageDisplay::convertFromMONO16(const sensor_msgs::msg::Image & _msg)
+{
+  unsigned int height = _msg.height;
+  unsigned int width = _msg.width;
 
   QImage image = QImage(width, height, QImage::Format_RGB888);
 
@@ -140,7 +169,7 @@ void ImageDisplay::updateFromMONO16()
   unsigned int bufferSize = samples * sizeof(uint16_t);
 
   uint16_t * buffer = new uint16_t[samples];
-  memcpy(buffer, &msg->data[0], bufferSize);
+  memcpy(buffer, &_msg.data[0], bufferSize);
 
   // Get min and max of temperature values
   uint16_t min = std::numeric_limits<uint16_t>::max();
@@ -173,17 +202,16 @@ void ImageDisplay::updateFromMONO16()
     }
   }
 
-  this->provider->SetImage(image);
-  this->newImage();
-
   delete[] buffer;
+
+  return image;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ImageDisplay::updateFromFloat32()
+QImage ImageDisplay::convertFromFloat32(const sensor_msgs::msg::Image & _msg)
 {
-  unsigned int height = msg->height;
-  unsigned int width = msg->width;
+  unsigned int height = _msg.height;
+  unsigned int width = _msg.width;
 
   QImage image = QImage(width, height, QImage::Format_RGB888);
 
@@ -193,7 +221,7 @@ void ImageDisplay::updateFromFloat32()
 
   float * depthBuffer = new float[depthSamples];
 
-  memcpy(depthBuffer, &msg->data[0], depthBufferSize);
+  memcpy(depthBuffer, &_msg.data[0], depthBufferSize);
 
   float maxDepth = 0;
   for (unsigned int i = 0; i < depthSamples; ++i) {
@@ -212,14 +240,16 @@ void ImageDisplay::updateFromFloat32()
     }
   }
 
-  this->provider->SetImage(image);
-  this->newImage();
-
   delete[] depthBuffer;
+
+  return image;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ImageDisplay::reset() {}
+void ImageDisplay::reset()
+{
+  this->clearPrepared();
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 QStringList ImageDisplay::getTopicList() const
@@ -230,7 +260,7 @@ QStringList ImageDisplay::getTopicList() const
 ////////////////////////////////////////////////////////////////////////////////
 void ImageDisplay::onRefresh()
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Clear
   this->topicList.clear();
@@ -238,17 +268,12 @@ void ImageDisplay::onRefresh()
   int index = 0, position = 0;
 
   // Get topic list
-  auto topics = this->node->get_topic_names_and_types();
-  for (const auto & topic : topics) {
-    for (const auto & topicType : topic.second) {
-      if (topicType == "sensor_msgs/msg/Image") {
-        this->topicList.push_back(QString::fromStdString(topic.first));
-        if (topic.first == this->topic_name) {
-          position = index;
-        }
-        index++;
-      }
+  for (const auto & topic : this->getTopicsByType("sensor_msgs/msg/Image")) {
+    this->topicList.push_back(QString::fromStdString(topic));
+    if (topic == this->topic_name) {
+      position = index;
     }
+    index++;
   }
   // Update combo-box
   this->topicListChanged();
@@ -260,7 +285,7 @@ void ImageDisplay::updateQoS(
   const int & _depth, const int & _history, const int & _reliability,
   const int & _durability)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->setHistoryDepth(_depth);
   this->setHistoryPolicy(_history);
   this->setReliabilityPolicy(_reliability);
@@ -32,7 +32,7 @@ namespace plugins
 {
 ////////////////////////////////////////////////////////////////////////////////
 LaserScanDisplay::LaserScanDisplay()
-: MessageDisplay(), visualType(rendering::LidarVisualType::LVT_POINTS)
+: PreparedMessageDisplay(), visualType(rendering::LidarVisualType::LVT_POINTS), dirty(false)
 {
   // Get reference to scene
   this->engine = ignition::rendering::engine("ogre");
@@ -49,7 +49,9 @@ LaserScanDisplay::LaserScanDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 LaserScanDisplay::~LaserScanDisplay()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  this->stopPreparing();
+
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Delete visual
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->removeEventFilter(this);
   this->scene->DestroyVisual(this->rootVisual);
@@ -58,25 +60,26 @@ LaserScanDisplay::~LaserScanDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 void LaserScanDisplay::initialize(rclcpp::Node::SharedPtr _node)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->node = std::move(_node);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void LaserScanDisplay::subscribe()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   this->subscriber = this->node->create_subscription<sensor_msgs::msg::LaserScan>(
     this->topic_name,
     this->qos,
-    std::bind(&LaserScanDisplay::callback, this, std::placeholders::_1));
+    std::bind(&LaserScanDisplay::callback, this, std::placeholders::_1),
+    this->subscriptionOptions());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void LaserScanDisplay::setTopic(const std::string & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name;
 
   this->subscribe();
@@ -88,7 +91,7 @@ void LaserScanDisplay::setTopic(const std::string & topic_name)
 ////////////////////////////////////////////////////////////////////////////////
 void LaserScanDisplay::setTopic(const QString & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name.toStdString();
 
   // Destroy previous subscription
@@ -100,10 +103,9 @@ void LaserScanDisplay::setTopic(const QString & topic_name)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void LaserScanDisplay::callback(const sensor_msgs::msg::LaserScan::SharedPtr _msg)
+void LaserScanDisplay::callback(const sensor_msgs::msg::LaserScan::ConstSharedPtr _msg)
 {
-  std::lock_guard<std::mutex>(this->lock);
-  this->msg = std::move(_msg);
+  this->receive(_msg);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -112,8 +114,9 @@ void LaserScanDisplay::callback(const sensor_msgs::msg::LaserScan::SharedPtr _ms
  */
 bool LaserScanDisplay::eventFilter(QObject * _object, QEvent * _event)
 {
-  if (_event->type() == gui::events::Render::kType) {
+  if (_event->type() == gui::events::Render::kType && this->beginUpdate()) {
     update();
+    this->endUpdate();
   }
 
   return QObject::eventFilter(_object, _event);
@@ -125,44 +128,68 @@ void LaserScanDisplay::reset()
   if (this->rootVisual != nullptr) {
     this->rootVisual->ClearPoints();
   }
-  this->msg.reset();
+  this->clearPrepared();
+  this->data.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void LaserScanDisplay::update()
 {
-  std::lock_guard<std::mutex>(this->lock);
-  if (!this->msg) {
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
+
+  // Pick up the latest prepared scan
+  auto latest = this->takePrepared();
+  if (latest) {
+    this->data = std::move(latest);
+    this->dirty = true;
+  }
+
+  if (!this->data) {
     return;
   }
 
-  // Update data
-  this->rootVisual->SetMinHorizontalAngle(this->msg->angle_min);
-  this->rootVisual->SetMaxHorizontalAngle(this->msg->angle_max);
-  this->rootVisual->SetMaxRange(this->msg->range_max);
-  this->rootVisual->SetMinRange(this->msg->range_min);
-  this->rootVisual->SetHorizontalRayCount(this->msg->ranges.size());
-  this->rootVisual->SetType(this->visualType);
-  this->rootVisual->SetPoints(
-    std::vector<double>(
-      this->msg->ranges.begin(),
-      this->msg->ranges.end()));
-
-  // Update visualization
-  this->rootVisual->Update();
+  if (this->uploadRequired(this->dirty)) {
+    // Upload data
+    this->rootVisual->SetMinHorizontalAngle(this->data->angleMin);
+    this->rootVisual->SetMaxHorizontalAngle(this->data->angleMax);
+    this->rootVisual->SetMaxRange(this->data->rangeMax);
+    this->rootVisual->SetMinRange(this->data->rangeMin);
+    this->rootVisual->SetHorizontalRayCount(this->data->ranges.size());
+    this->rootVisual->SetType(this->visualType);
+    this->rootVisual->SetPoints(this->data->ranges);
+
+    // Update visualization
+    this->rootVisual->Update();
+    this->dirty = false;
+  }
 
   // Set position and orientation of the frame link
   math::Pose3d pose;
-  bool poseAvailable = this->frameManager->getFramePose(this->msg->header.frame_id, pose);
+  bool poseAvailable = this->frameManager->getFramePose(
+    this->data->header.frame_id, this->data->header.stamp, pose);
   if (poseAvailable) {
     this->rootVisual->SetLocalPose(pose);
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+LaserScanDisplay::PreparedPtr LaserScanDisplay::prepare(const sensor_msgs::msg::LaserScan & _msg)
+{
+  auto scan = std::make_shared<LaserScanData>();
+  scan->header = _msg.header;
+  scan->angleMin = _msg.angle_min;
+  scan->angleMax = _msg.angle_max;
+  scan->rangeMin = _msg.range_min;
+  scan->rangeMax = _msg.range_max;
+  scan->ranges.assign(_msg.ranges.begin(), _msg.ranges.end());
+
+  return scan;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void LaserScanDisplay::setFrameManager(std::shared_ptr<common::FrameManager> _frameManager)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->frameManager = std::move(_frameManager);
   this->fixedFrame = this->frameManager->getFixedFrame();
 }
@@ -177,7 +204,7 @@ QStringList LaserScanDisplay::getTopicList() const
 ////////////////////////////////////////////////////////////////////////////////
 void LaserScanDisplay::onRefresh()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Clear
   this->topicList.clear();
@@ -185,17 +212,12 @@ void LaserScanDisplay::onRefresh()
   int index = 0, position = 0;
 
   // Get topic list
-  auto topics = this->node->get_topic_names_and_types();
-  for (const auto & topic : topics) {
-    for (const auto & topicType : topic.second) {
-      if (topicType == "sensor_msgs/msg/LaserScan") {
-        this->topicList.push_back(QString::fromStdString(topic.first));
-        if (topic.first == this->topic_name) {
-          position = index;
-        }
-        index++;
-      }
+  for (const auto & topic : this->getTopicsByType("sensor_msgs/msg/LaserScan")) {
+    this->topicList.push_back(QString::fromStdString(topic));
+    if (topic == this->topic_name) {
+      position = index;
     }
+    index++;
   }
   // Update combo-box
   this->topicListChanged();
@@ -205,7 +227,7 @@ void LaserScanDisplay::onRefresh()
 ////////////////////////////////////////////////////////////////////////////////
 void LaserScanDisplay::setVisualType(const int & _type)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Set visual type
   switch (_type) {
@@ -216,6 +238,9 @@ void LaserScanDisplay::setVisualType(const int & _type)
     case 2: this->visualType = rendering::LidarVisualType::LVT_TRIANGLE_STRIPS;
       break;
   }
+
+  // Upload the current scan again with the new type
+  this->dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -223,7 +248,7 @@ void LaserScanDisplay::updateQoS(
   const int & _depth, const int & _history, const int & _reliability,
   const int & _durability)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->setHistoryDepth(_depth);
   this->setHistoryPolicy(_history);
   this->setReliabilityPolicy(_reliability);
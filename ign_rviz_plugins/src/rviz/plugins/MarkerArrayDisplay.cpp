@@ -24,6 +24,8 @@
 #include <utility>
 #include <vector>
 
+#include "ignition/rviz/common/rviz_events.hpp"
+
 namespace ignition
 {
 namespace rviz
@@ -37,32 +39,33 @@ MarkerArrayDisplay::MarkerArrayDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 MarkerArrayDisplay::~MarkerArrayDisplay()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->removeEventFilter(this);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerArrayDisplay::initialize(rclcpp::Node::SharedPtr _node)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->node = std::move(_node);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerArrayDisplay::subscribe()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   this->subscriber = this->node->create_subscription<visualization_msgs::msg::MarkerArray>(
     this->topic_name,
     this->qos,
-    std::bind(&MarkerArrayDisplay::callback, this, std::placeholders::_1));
+    std::bind(&MarkerArrayDisplay::callback, this, std::placeholders::_1),
+    this->subscriptionOptions());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerArrayDisplay::setTopic(const std::string & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name;
 
   this->subscribe();
@@ -74,7 +77,7 @@ void MarkerArrayDisplay::setTopic(const std::string & topic_name)
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerArrayDisplay::setTopic(const QString & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name.toStdString();
 
   // Destroy previous subscription
@@ -86,17 +89,31 @@ void MarkerArrayDisplay::setTopic(const QString & topic_name)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void MarkerArrayDisplay::callback(const visualization_msgs::msg::MarkerArray::SharedPtr _msg)
+void MarkerArrayDisplay::callback(const visualization_msgs::msg::MarkerArray::ConstSharedPtr _msg)
+{
+  this->receive(_msg);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerArrayDisplay::receive(visualization_msgs::msg::MarkerArray::ConstSharedPtr _msg)
 {
-  std::lock_guard<std::mutex>(this->lock);
-  this->msg = std::move(_msg);
+  // Markers are incremental, so every message is queued regardless of the update policy
+  const int64_t receiveTime = this->recordReceive(this->stampLatencyOf(*_msg));
+  this->markerQueue.post(_msg, receiveTime);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool MarkerArrayDisplay::eventFilter(QObject * _object, QEvent * _event)
 {
-  if (_event->type() == gui::events::Render::kType) {
+  if (_event->type() == gui::events::Render::kType && this->beginUpdate()) {
     update();
+    this->endUpdate();
+  }
+
+  // Markers are placed relative to the fixed frame
+  if (_event->type() == rviz::events::FixedFrameChanged::kType) {
+    std::lock_guard<std::recursive_mutex> guard(this->lock);
+    this->markerManager->resetPoses();
   }
 
   return QObject::eventFilter(_object, _event);
@@ -105,29 +122,38 @@ bool MarkerArrayDisplay::eventFilter(QObject * _object, QEvent * _event)
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerArrayDisplay::reset()
 {
-  this->msg.reset();
+  this->markerQueue.clear();
+  this->markerManager->deleteAllMarkers();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerArrayDisplay::update()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
-  if (!this->msg) {
-    return;
+  // Apply the latest pending message of every marker in order
+  std::vector<MarkerQueue::MarkerPtr> markers;
+  int64_t receiveTime = 0;
+  if (this->takeAllowed() && this->markerQueue.take(markers, receiveTime)) {
+    this->recordRender(receiveTime);
+    this->recordTake();
   }
+  this->sampleStatistics(this->markerQueue.dropped());
 
-  markerManager->processMessage(*this->msg);
+  for (const auto & marker : markers) {
+    this->markerManager->processMessage(*marker);
+  }
 
-  // Avoid visualizing same data again
-  this->msg.reset();
+  // Remove expired markers and move frame locked markers, even without new data
+  this->markerManager->update();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerArrayDisplay::setFrameManager(std::shared_ptr<common::FrameManager> _frameManager)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->frameManager = std::move(_frameManager);
+  this->markerManager->setFrameManager(this->frameManager);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -139,7 +165,7 @@ QStringList MarkerArrayDisplay::getTopicList() const
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerArrayDisplay::onRefresh()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Clear
   this->topicList.clear();
@@ -147,17 +173,12 @@ void MarkerArrayDisplay::onRefresh()
   int index = 0, position = 0;
 
   // Get topic list
-  auto topics = this->node->get_topic_names_and_types();
-  for (const auto & topic : topics) {
-    for (const auto & topicType : topic.second) {
-      if (topicType == "visualization_msgs/msg/MarkerArray") {
-        this->topicList.push_back(QString::fromStdString(topic.first));
-        if (topic.first == this->topic_name) {
-          position = index;
-        }
-        index++;
-      }
+  for (const auto & topic : this->getTopicsByType("visualization_msgs/msg/MarkerArray")) {
+    this->topicList.push_back(QString::fromStdString(topic));
+    if (topic == this->topic_name) {
+      position = index;
     }
+    index++;
   }
   // Update combo-box
   this->topicListChanged();
@@ -169,7 +190,7 @@ void MarkerArrayDisplay::updateQoS(
   const int & _depth, const int & _history, const int & _reliability,
   const int & _durability)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->setHistoryDepth(_depth);
   this->setHistoryPolicy(_history);
   this->setReliabilityPolicy(_reliability);
@@ -19,7 +19,13 @@
 #include <rclcpp/logger.hpp>
 #include <rclcpp/logging.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace ignition
 {
@@ -27,8 +33,134 @@ namespace rviz
 {
 namespace plugins
 {
+////////////////////////////////////////////////////////////////////////////////
+static int64_t steadyNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool isListGeometry(int _type)
+{
+  return _type == visualization_msgs::msg::Marker::LINE_STRIP ||
+         _type == visualization_msgs::msg::Marker::LINE_LIST ||
+         _type == visualization_msgs::msg::Marker::TRIANGLE_LIST ||
+         _type == visualization_msgs::msg::Marker::POINTS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool isShapeList(int _type)
+{
+  return _type == visualization_msgs::msg::Marker::CUBE_LIST ||
+         _type == visualization_msgs::msg::Marker::SPHERE_LIST;
+}
+
+/// Frames a marker waits for the transform at its stamp before the latest transform is used
+static const unsigned int kStampedPoseRetries = 30;
+
+/// Frames a marker is retried to be placed before it is no longer tracked
+static const unsigned int kMaxPoseRetries = 600;
+
+/// Shapes drawn at most by a merged shape list, bounds it to 3.6M vertices for cubes
+/// and 6M vertices for spheres
+static const size_t kMaxMergedShapes = 100000;
+
+////////////////////////////////////////////////////////////////////////////////
+static size_t mergedShapeCount(const visualization_msgs::msg::Marker & _msg)
+{
+  return std::min(_msg.points.size(), kMaxMergedShapes);
+}
+
+/**
+ * @brief Triangles of a unit shape, drawn once per point of a merged shape list
+ */
+struct ShapeTemplate
+{
+  std::vector<math::Vector3d> vertices;
+  /// Color factor of each vertex, shades the faces since list geometry is unlit
+  std::vector<double> shades;
+
+  void addTriangle(math::Vector3d _a, math::Vector3d _b, math::Vector3d _c)
+  {
+    // Wind counter-clockwise seen from outside of the shape
+    math::Vector3d normal = (_b - _a).Cross(_c - _a);
+    if (normal.Dot(_a + _b + _c) < 0) {
+      std::swap(_b, _c);
+      normal = -normal;
+    }
+
+    // Lit from above
+    const double shade = 0.6 + 0.4 * (0.5 + 0.5 * normal.Normalized().Z());
+    for (const auto & vertex : {_a, _b, _c}) {
+      this->vertices.push_back(vertex);
+      this->shades.push_back(shade);
+    }
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+static const ShapeTemplate & cubeTemplate()
+{
+  static const ShapeTemplate shape = []() {
+      ShapeTemplate cube;
+      auto corner = [](int _index) {
+          return math::Vector3d(
+            (_index & 1) ? 0.5 : -0.5, (_index & 2) ? 0.5 : -0.5, (_index & 4) ? 0.5 : -0.5);
+        };
+
+      // Corners of each face, indexed by their bits x, y and z
+      const int faces[6][4] = {
+        {0, 1, 3, 2}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 3, 7, 5}};
+      for (const auto & face : faces) {
+        cube.addTriangle(corner(face[0]), corner(face[1]), corner(face[2]));
+        cube.addTriangle(corner(face[0]), corner(face[2]), corner(face[3]));
+      }
+      return cube;
+    }();
+
+  return shape;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static const ShapeTemplate & sphereTemplate()
+{
+  static const ShapeTemplate shape = []() {
+      ShapeTemplate sphere;
+
+      // Icosahedron of unit diameter
+      const double t = (1.0 + std::sqrt(5.0)) / 2.0;
+      std::vector<math::Vector3d> vertices = {
+        {-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0},
+        {0, -1, t}, {0, 1, t}, {0, -1, -t}, {0, 1, -t},
+        {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1}};
+      for (auto & vertex : vertices) {
+        vertex = vertex.Normalized() * 0.5;
+      }
+
+      const int faces[20][3] = {
+        {0, 11, 5}, {0, 5, 1}, {0, 1, 7}, {0, 7, 10}, {0, 10, 11},
+        {1, 5, 9}, {5, 11, 4}, {11, 10, 2}, {10, 7, 6}, {7, 1, 8},
+        {3, 9, 4}, {3, 4, 2}, {3, 2, 6}, {3, 6, 8}, {3, 8, 9},
+        {4, 9, 5}, {2, 4, 11}, {6, 2, 10}, {8, 6, 7}, {9, 8, 1}};
+      for (const auto & face : faces) {
+        sphere.addTriangle(vertices[face[0]], vertices[face[1]], vertices[face[2]]);
+      }
+      return sphere;
+    }();
+
+  return shape;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static const ShapeTemplate & shapeTemplate(int _type)
+{
+  return (_type == visualization_msgs::msg::Marker::CUBE_LIST) ? cubeTemplate() : sphereTemplate();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 MarkerManager::MarkerManager()
+: generation(0)
 {
   // Get reference to scene
   this->engine = ignition::rendering::engine("ogre");
@@ -36,12 +168,15 @@ MarkerManager::MarkerManager()
 
   this->rootVisual = this->scene->CreateVisual();
   this->scene->RootVisual()->AddChild(this->rootVisual);
+
+  this->materialCache = common::MaterialCache::instance(this->scene);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 MarkerManager::~MarkerManager()
 {
   // Delete all markers
+  this->deleteAllMarkers();
   this->scene->DestroyVisual(this->rootVisual, true);
 }
 
@@ -62,7 +197,7 @@ void MarkerManager::processMessage(const visualization_msgs::msg::Marker & _msg)
         break;
       }
     case visualization_msgs::msg::Marker::DELETE: {
-        deleteMarker(_msg.id);
+        deleteMarker(_msg.ns, _msg.id);
         break;
       }
     case visualization_msgs::msg::Marker::DELETEALL: {
@@ -75,6 +210,13 @@ void MarkerManager::processMessage(const visualization_msgs::msg::Marker & _msg)
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerManager::createMarker(const visualization_msgs::msg::Marker & _msg)
 {
+  const MarkerKey key{_msg.ns, _msg.id};
+  auto it = this->markers.find(key);
+  if (it != this->markers.end() && canUpdate(it->second.msg, _msg)) {
+    updateMarker(it->first, it->second, _msg);
+    return;
+  }
+
   switch (_msg.type) {
     case visualization_msgs::msg::Marker::ARROW: {
         createArrowMarker(_msg);
@@ -133,21 +275,21 @@ void MarkerManager::createBasicGeometry(
   rendering::MarkerType _geometryType)
 {
   rendering::VisualPtr visual = this->scene->CreateVisual();
-  insertOrUpdateVisual(_msg.id, visual);
+  MarkerEntry & entry = insertOrUpdateVisual(_msg, visual);
 
   // Create marker
   auto marker = this->scene->CreateMarker();
   marker->SetType(_geometryType);
+  entry.geometry = marker;
 
   // Set material
-  marker->SetMaterial(createMaterial(_msg.color));
+  entry.material = acquireMaterial(_msg.color);
+  marker->SetMaterial(entry.material, false);
 
   // Add geometry and set scale
   visual->AddGeometry(marker);
   visual->SetLocalScale(_msg.scale.x, _msg.scale.y, _msg.scale.z);
-  visual->SetLocalPose(msgToPose(_msg.pose));
-
-  this->rootVisual->AddChild(visual);
+  setVisualPose(visual, _msg);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -156,60 +298,120 @@ void MarkerManager::createListGeometry(
   rendering::MarkerType _geometryType)
 {
   rendering::VisualPtr visual = this->scene->CreateVisual();
-  insertOrUpdateVisual(_msg.id, visual);
+  MarkerEntry & entry = insertOrUpdateVisual(_msg, visual);
 
   auto marker = this->scene->CreateMarker();
   marker->SetType(_geometryType);
+  entry.geometry = marker;
 
-  if (_msg.colors.size() == _msg.points.size()) {
-    for (unsigned int i = 0; i < _msg.points.size(); ++i) {
-      const auto & point = _msg.points[i];
-      const auto color = math::Color(
-        _msg.colors[i].r, _msg.colors[i].g, _msg.colors[i].b, _msg.colors[i].a);
-      marker->AddPoint(point.x, point.y, point.z, color);
-    }
-  } else {
-    if (_msg.colors.size() != 0) {
-      RCLCPP_WARN(
-        rclcpp::get_logger("MarkerManager"), "Marker color and point array size doesn't match.");
-    }
-    const auto color = math::Color(_msg.color.r, _msg.color.g, _msg.color.b, _msg.color.a);
-    for (const auto & point : _msg.points) {
-      marker->AddPoint(point.x, point.y, point.z, color);
-    }
-  }
+  addListPoints(marker, _msg);
 
   // This material is not used anywhere but is required to set
   // point color in marker AddPoint method
-  marker->SetMaterial(this->scene->Material("Default/TransGreen"));
+  marker->SetMaterial(this->scene->Material("Default/TransGreen"), false);
 
   visual->AddGeometry(marker);
-  visual->SetLocalPose(msgToPose(_msg.pose));
+  setVisualPose(visual, _msg);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool usesPointColors(const visualization_msgs::msg::Marker & _msg)
+{
+  return !_msg.points.empty() && _msg.colors.size() == _msg.points.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool colorsKept(
+  const visualization_msgs::msg::Marker & _previous,
+  const visualization_msgs::msg::Marker & _msg, size_t _kept)
+{
+  if (_kept == 0) {
+    return true;
+  }
+  if (_msg.points.size() < _kept) {
+    return false;
+  }
+
+  if (usesPointColors(_previous) && usesPointColors(_msg)) {
+    return std::equal(
+      _previous.colors.begin(), _previous.colors.begin() + _kept, _msg.colors.begin());
+  }
+  if (!usesPointColors(_previous) && !usesPointColors(_msg)) {
+    return _previous.color == _msg.color;
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::addListPoints(
+  rendering::MarkerPtr _geometry,
+  const visualization_msgs::msg::Marker & _msg,
+  size_t _first)
+{
+  if (_first >= _msg.points.size()) {
+    return;
+  }
+
+  const bool pointColors = usesPointColors(_msg);
+  if (!pointColors && _msg.colors.size() != 0) {
+    RCLCPP_WARN(
+      rclcpp::get_logger("MarkerManager"), "Marker color and point array size doesn't match.");
+  }
+
+  for (size_t i = _first; i < _msg.points.size(); ++i) {
+    const auto & point = _msg.points[i];
+    const auto & color = pointColors ? _msg.colors[i] : _msg.color;
+    _geometry->AddPoint(
+      math::Vector3d(point.x, point.y, point.z),
+      math::Color(color.r, color.g, color.b, color.a));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::updateListPoints(
+  MarkerEntry & _entry,
+  const visualization_msgs::msg::Marker & _msg)
+{
+  const auto & previous = _entry.msg;
+  const size_t kept = previous.points.size();
+
+  // Colors are set when a point is added, existing points can only be moved
+  if (!colorsKept(previous, _msg, kept)) {
+    _entry.geometry->ClearPoints();
+    addListPoints(_entry.geometry, _msg);
+    return;
+  }
 
-  this->rootVisual->AddChild(visual);
+  // Move the points which changed and append the new ones, growing lists
+  // such as map meshes are not rebuilt. The geometry still uploads all of
+  // its vertices again on the next render.
+  for (size_t i = 0; i < kept; ++i) {
+    const auto & point = _msg.points[i];
+    if (point != previous.points[i]) {
+      _entry.geometry->SetPoint(i, math::Vector3d(point.x, point.y, point.z));
+    }
+  }
+  addListPoints(_entry.geometry, _msg, kept);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerManager::createArrowMarker(const visualization_msgs::msg::Marker & _msg)
 {
   auto visual = this->scene->CreateArrowVisual();
-  insertOrUpdateVisual(_msg.id, visual);
+  MarkerEntry & entry = insertOrUpdateVisual(_msg, visual);
 
-  visual->SetMaterial(createMaterial(_msg.color));
+  entry.material = acquireMaterial(_msg.color);
+  visual->SetMaterial(entry.material, false);
   visual->SetLocalScale(_msg.scale.x, _msg.scale.y, _msg.scale.z);
 
-  math::Pose3d pose = msgToPose(_msg.pose);
-  visual->SetLocalPosition(pose.Pos());
-  visual->SetLocalRotation(pose.Rot() * math::Quaterniond(0, 1.57, 0));
-
-  this->rootVisual->AddChild(visual);
+  setVisualPose(visual, _msg);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerManager::createTextMarker(const visualization_msgs::msg::Marker & _msg)
 {
   rendering::VisualPtr visual = this->scene->CreateVisual();
-  insertOrUpdateVisual(_msg.id, visual);
+  MarkerEntry & entry = insertOrUpdateVisual(_msg, visual);
 
   // Create text marker
   auto textMarker = this->scene->CreateText();
@@ -219,15 +421,15 @@ void MarkerManager::createTextMarker(const visualization_msgs::msg::Marker & _ms
     rendering::TextHorizontalAlign::CENTER,
     rendering::TextVerticalAlign::CENTER);
   textMarker->SetCharHeight(0.15);
-  textMarker->SetMaterial(createMaterial(_msg.color));
+  entry.material = acquireMaterial(_msg.color);
+  textMarker->SetMaterial(entry.material, false);
+  entry.text = textMarker;
 
   // Add geometry and set scale
   visual->AddGeometry(textMarker);
   visual->SetLocalScale(_msg.scale.x, _msg.scale.y, _msg.scale.z);
 
-  visual->SetLocalPose(msgToPose(_msg.pose));
-
-  this->rootVisual->AddChild(visual);
+  setVisualPose(visual, _msg);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -268,69 +470,119 @@ void MarkerManager::createMeshMarker(const visualization_msgs::msg::Marker & _ms
   rendering::MeshPtr mesh = this->scene->CreateMesh(descriptor);
 
   rendering::VisualPtr visual = this->scene->CreateVisual();
-  insertOrUpdateVisual(_msg.id, visual);
+  MarkerEntry & entry = insertOrUpdateVisual(_msg, visual);
 
   if (!_msg.mesh_use_embedded_materials) {
-    mesh->SetMaterial(createMaterial(_msg.color));
+    entry.material = acquireMaterial(_msg.color);
+    mesh->SetMaterial(entry.material, false);
   }
 
   visual->AddGeometry(mesh);
   visual->SetLocalScale(_msg.scale.x, _msg.scale.y, _msg.scale.z);
 
-  visual->SetLocalPose(msgToPose(_msg.pose));
-
-  this->rootVisual->AddChild(visual);
+  setVisualPose(visual, _msg);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerManager::createListVisual(const visualization_msgs::msg::Marker & _msg)
 {
   rendering::VisualPtr visual = this->scene->CreateVisual();
-  insertOrUpdateVisual(_msg.id, visual);
+  MarkerEntry & entry = insertOrUpdateVisual(_msg, visual);
 
-  if (_msg.colors.size() == _msg.points.size()) {
-    for (unsigned int i = 0; i < _msg.points.size(); ++i) {
-      auto geometry = (_msg.type == visualization_msgs::msg::Marker::CUBE_LIST) ?
-        this->scene->CreateBox() : this->scene->CreateSphere();
+  // All shapes are drawn by a single triangle list
+  auto marker = this->scene->CreateMarker();
+  marker->SetType(rendering::MarkerType::MT_TRIANGLE_LIST);
+  entry.geometry = marker;
 
-      geometry->SetMaterial(createMaterial(_msg.colors[i]));
-      auto marker = this->scene->CreateVisual();
-      marker->SetLocalPosition(_msg.points[i].x, _msg.points[i].y, _msg.points[i].z);
-      marker->SetLocalScale(_msg.scale.x, _msg.scale.y, _msg.scale.z);
-      marker->AddGeometry(geometry);
+  addListShapes(entry, _msg);
 
-      visual->AddChild(marker);
-    }
-  } else {
-    auto mat = createMaterial(_msg.color);
-    for (const auto & point : _msg.points) {
-      auto geometry = (_msg.type == visualization_msgs::msg::Marker::CUBE_LIST) ?
-        this->scene->CreateBox() : this->scene->CreateSphere();
-
-      geometry->SetMaterial(mat, false);
-      auto marker = this->scene->CreateVisual();
-      marker->SetLocalPosition(point.x, point.y, point.z);
-      marker->SetLocalScale(_msg.scale.x, _msg.scale.y, _msg.scale.z);
-      marker->AddGeometry(geometry);
-
-      visual->AddChild(marker);
+  // Required to set vertex color in marker AddPoint method
+  marker->SetMaterial(this->scene->Material("Default/TransGreen"), false);
+
+  visual->AddGeometry(marker);
+  setVisualPose(visual, _msg);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::addListShapes(
+  MarkerEntry & _entry,
+  const visualization_msgs::msg::Marker & _msg,
+  size_t _first)
+{
+  const ShapeTemplate & shape = shapeTemplate(_msg.type);
+  const math::Vector3d scale(_msg.scale.x, _msg.scale.y, _msg.scale.z);
+  const bool pointColors = usesPointColors(_msg);
+
+  if (!pointColors && _msg.colors.size() != 0) {
+    RCLCPP_WARN(
+      rclcpp::get_logger("MarkerManager"), "Marker color and point array size doesn't match.");
+  }
+
+  // Reported for each marker once its list becomes truncated
+  const bool truncated = _msg.points.size() > kMaxMergedShapes;
+  if (truncated && !_entry.truncated) {
+    RCLCPP_ERROR(
+      rclcpp::get_logger("MarkerManager"),
+      "Shape list marker %s/%d has %zu points, only the first %zu are drawn.",
+      _msg.ns.c_str(), _msg.id, _msg.points.size(), kMaxMergedShapes);
+  }
+  _entry.truncated = truncated;
+
+  const size_t count = mergedShapeCount(_msg);
+  for (size_t i = _first; i < count; ++i) {
+    const auto & point = _msg.points[i];
+    const math::Vector3d center(point.x, point.y, point.z);
+    const auto & color = pointColors ? _msg.colors[i] : _msg.color;
+
+    for (unsigned int j = 0; j < shape.vertices.size(); ++j) {
+      const double shade = shape.shades[j];
+      _entry.geometry->AddPoint(
+        center + shape.vertices[j] * scale,
+        math::Color(color.r * shade, color.g * shade, color.b * shade, color.a));
     }
   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::updateListShapes(
+  MarkerEntry & _entry,
+  const visualization_msgs::msg::Marker & _msg)
+{
+  const auto & previous = _entry.msg;
+  const size_t kept = mergedShapeCount(previous);
+
+  // Colors are set when a vertex is added, existing shapes can only be moved
+  if (!colorsKept(previous, _msg, kept)) {
+    _entry.geometry->ClearPoints();
+    addListShapes(_entry, _msg);
+    return;
+  }
 
-  visual->SetLocalPose(msgToPose(_msg.pose));
+  // Move the shapes which changed, a new scale moves the vertices of all shapes.
+  // This saves rebuilding the list, all vertices are still uploaded again.
+  const ShapeTemplate & shape = shapeTemplate(_msg.type);
+  const math::Vector3d scale(_msg.scale.x, _msg.scale.y, _msg.scale.z);
+  const bool scaled = previous.scale != _msg.scale;
+  const size_t count = shape.vertices.size();
+
+  for (size_t i = 0; i < kept; ++i) {
+    const auto & point = _msg.points[i];
+    if (!scaled && point == previous.points[i]) {
+      continue;
+    }
 
-  this->rootVisual->AddChild(visual);
+    const math::Vector3d center(point.x, point.y, point.z);
+    for (size_t j = 0; j < count; ++j) {
+      _entry.geometry->SetPoint(i * count + j, center + shape.vertices[j] * scale);
+    }
+  }
+  addListShapes(_entry, _msg, kept);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-rendering::MaterialPtr MarkerManager::createMaterial(const std_msgs::msg::ColorRGBA & _color)
+rendering::MaterialPtr MarkerManager::acquireMaterial(const std_msgs::msg::ColorRGBA & _color)
 {
-  auto mat = this->scene->CreateMaterial();
-  mat->SetAmbient(_color.r, _color.g, _color.b, _color.a);
-  mat->SetDiffuse(_color.r, _color.g, _color.b, _color.a);
-  mat->SetEmissive(_color.r, _color.g, _color.b, _color.a);
-
-  return mat;
+  return this->materialCache->acquire(_color);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -342,37 +594,301 @@ math::Pose3d MarkerManager::msgToPose(const geometry_msgs::msg::Pose & _pose)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void MarkerManager::insertOrUpdateVisual(unsigned int _id, rendering::VisualPtr _visual)
+MarkerManager::MarkerEntry & MarkerManager::insertOrUpdateVisual(
+  const visualization_msgs::msg::Marker & _msg,
+  rendering::VisualPtr _visual)
+{
+  MarkerKey key{_msg.ns, _msg.id};
+
+  auto it = this->markers.find(key);
+  if (it != this->markers.end()) {
+    // Destroy previously created visual with same namespace and ID
+    this->scene->DestroyVisual(it->second.visual, true);
+    releaseMaterials(it->second);
+  } else {
+    MarkerEntry entry;
+    entry.frameVisual = this->scene->CreateVisual();
+    entry.visible = false;
+    this->rootVisual->AddChild(entry.frameVisual);
+    it = this->markers.emplace(key, std::move(entry)).first;
+  }
+
+  MarkerEntry & entry = it->second;
+  entry.visual = _visual;
+  entry.frameVisual->AddChild(_visual);
+  // Markers are hidden until placed, applied again to reach the new visual
+  entry.frameVisual->SetVisible(entry.visible);
+  entry.geometry.reset();
+  entry.text.reset();
+  entry.truncated = false;
+  entry.msg = _msg;
+
+  trackMarker(it->first, entry, _msg);
+
+  return entry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MarkerManager::canUpdate(
+  const visualization_msgs::msg::Marker & _previous,
+  const visualization_msgs::msg::Marker & _msg) const
+{
+  if (_previous.type != _msg.type) {
+    return false;
+  }
+
+  switch (_msg.type) {
+    case visualization_msgs::msg::Marker::MESH_RESOURCE:
+      return _previous.mesh_resource == _msg.mesh_resource &&
+             _previous.mesh_use_embedded_materials == _msg.mesh_use_embedded_materials;
+    default:
+      return true;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::updateMarker(
+  const MarkerKey & _key, MarkerEntry & _entry,
+  const visualization_msgs::msg::Marker & _msg)
 {
-  auto it = visuals.find(_id);
-  if (it != visuals.end()) {
-    // Destroy previously created visual with same ID
-    this->scene->DestroyVisual(it->second, true);
-    it->second = _visual;
+  const auto & previous = _entry.msg;
+
+  if (previous.pose != _msg.pose) {
+    setVisualPose(_entry.visual, _msg);
+  }
+
+  // List geometry points are not scaled, shape lists apply the scale to each shape
+  if (previous.scale != _msg.scale && !isListGeometry(_msg.type) && !isShapeList(_msg.type)) {
+    _entry.visual->SetLocalScale(_msg.scale.x, _msg.scale.y, _msg.scale.z);
+  }
+
+  if (_entry.material && previous.color != _msg.color) {
+    // Materials are shared, switch to the material of the new color
+    auto material = acquireMaterial(_msg.color);
+    _entry.visual->SetMaterial(material, false);
+    this->materialCache->release(_entry.material);
+    _entry.material = material;
+  }
+
+  if (_entry.text && previous.text != _msg.text) {
+    _entry.text->SetTextString(_msg.text);
+  }
+
+  // Compares the points itself, avoids a second pass over large lists
+  if (_entry.geometry && isListGeometry(_msg.type)) {
+    updateListPoints(_entry, _msg);
+  }
+
+  if (_entry.geometry && isShapeList(_msg.type) &&
+    (previous.points != _msg.points || previous.colors != _msg.colors ||
+    previous.color != _msg.color || previous.scale != _msg.scale))
+  {
+    updateListShapes(_entry, _msg);
+  }
+
+  _entry.msg = _msg;
+  trackMarker(_key, _entry, _msg);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::trackMarker(
+  const MarkerKey & _key, MarkerEntry & _entry,
+  const visualization_msgs::msg::Marker & _msg)
+{
+  _entry.frameId = _msg.header.frame_id;
+  _entry.stamp = _msg.header.stamp;
+  _entry.frameLocked = _msg.frame_locked;
+  _entry.poseValid = false;
+  _entry.poseRetries = 0;
+  _entry.generation = ++this->generation;
+
+  const int64_t lifetime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::seconds(_msg.lifetime.sec) +
+    std::chrono::nanoseconds(_msg.lifetime.nanosec)).count();
+  _entry.expiry = (lifetime > 0) ? steadyNow() + lifetime : 0;
+
+  this->updateFramePose(_entry);
+  if (_entry.frameLocked || !_entry.poseValid) {
+    this->trackedMarkers.insert(_key);
   } else {
-    visuals.insert({_id, _visual});
+    this->trackedMarkers.erase(_key);
+  }
+
+  this->scheduleExpiry(_key, _entry);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::setVisualPose(
+  rendering::VisualPtr _visual,
+  const visualization_msgs::msg::Marker & _msg)
+{
+  math::Pose3d pose = msgToPose(_msg.pose);
+
+  // Arrow visual points along the z-axis, marker arrows along the x-axis
+  if (_msg.type == visualization_msgs::msg::Marker::ARROW) {
+    pose.Rot() = pose.Rot() * math::Quaterniond(0, 1.57, 0);
+  }
+
+  _visual->SetLocalPose(pose);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::setFrameManager(std::shared_ptr<common::FrameManager> _frameManager)
+{
+  this->frameManager = std::move(_frameManager);
+
+  // Place all markers using the new frame manager
+  this->resetPoses();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::resetPoses()
+{
+  // Markers which are not frame locked are otherwise only placed once
+  for (auto & marker : this->markers) {
+    marker.second.poseValid = false;
+    // The stamp may be older than the buffer history, use the latest transform right away
+    marker.second.poseRetries = kStampedPoseRetries;
+    this->trackedMarkers.insert(marker.first);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::update()
+{
+  // Remove expired markers
+  const int64_t now = steadyNow();
+  while (!this->expiries.empty() && this->expiries.top().time <= now) {
+    const MarkerExpiry expiry = this->expiries.top();
+    this->expiries.pop();
+
+    auto it = this->markers.find(expiry.key);
+    if (it != this->markers.end() && it->second.generation == expiry.generation) {
+      this->destroyMarker(it);
+    }
+  }
+
+  // Follow frame locked markers and place markers whose frame was not available yet
+  for (auto it = this->trackedMarkers.begin(); it != this->trackedMarkers.end(); ) {
+    auto marker = this->markers.find(*it);
+    if (marker == this->markers.end()) {
+      it = this->trackedMarkers.erase(it);
+      continue;
+    }
+
+    MarkerEntry & entry = marker->second;
+    this->updateFramePose(entry);
+    if (!entry.frameLocked && entry.poseValid) {
+      it = this->trackedMarkers.erase(it);
+    } else if (!entry.poseValid && entry.poseRetries >= kMaxPoseRetries) {
+      // Tracked again on the next message or fixed frame change
+      RCLCPP_WARN(
+        rclcpp::get_logger("MarkerManager"), "Could not place marker %s/%d in frame %s",
+        marker->first.ns.c_str(), marker->first.id, entry.frameId.c_str());
+      it = this->trackedMarkers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::updateFramePose(MarkerEntry & _entry)
+{
+  // Without frame information markers are placed in the fixed frame
+  if (this->frameManager && !_entry.frameId.empty()) {
+    math::Pose3d pose;
+    bool valid = false;
+    if (!_entry.frameLocked) {
+      valid = this->frameManager->getFramePose(_entry.frameId, _entry.stamp, pose);
+    }
+
+    // Frame locked markers follow the latest transform, other markers fall back to it
+    // once the transform at their stamp did not become available
+    if (!valid && (_entry.frameLocked || _entry.poseRetries >= kStampedPoseRetries)) {
+      valid = this->frameManager->getFramePose(_entry.frameId, pose);
+    }
+
+    if (!valid) {
+      _entry.poseRetries++;
+      return;
+    }
+    _entry.frameVisual->SetLocalPose(pose);
+  }
+
+  _entry.poseValid = true;
+  _entry.poseRetries = 0;
+  if (!_entry.visible) {
+    _entry.frameVisual->SetVisible(true);
+    _entry.visible = true;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::scheduleExpiry(const MarkerKey & _key, const MarkerEntry & _entry)
+{
+  if (_entry.expiry == 0) {
+    return;
   }
+
+  this->expiries.push(MarkerExpiry{_entry.expiry, _entry.generation, _key});
+
+  // Markers republished at a high rate leave stale entries behind, rebuild
+  // the heap from the store once they outnumber the live markers
+  if (this->expiries.size() > 2 * this->markers.size() + 64) {
+    std::vector<MarkerExpiry> live;
+    live.reserve(this->markers.size());
+    for (const auto & marker : this->markers) {
+      if (marker.second.expiry != 0) {
+        live.push_back(
+          MarkerExpiry{marker.second.expiry, marker.second.generation, marker.first});
+      }
+    }
+
+    this->expiries = std::priority_queue<MarkerExpiry, std::vector<MarkerExpiry>,
+        std::greater<MarkerExpiry>>(std::greater<MarkerExpiry>(), std::move(live));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerManager::releaseMaterials(MarkerEntry & _entry)
+{
+  this->materialCache->release(_entry.material);
+  _entry.material.reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MarkerManager::MarkerMap::iterator MarkerManager::destroyMarker(MarkerMap::iterator _it)
+{
+  this->scene->DestroyVisual(_it->second.frameVisual, true);
+  releaseMaterials(_it->second);
+  this->trackedMarkers.erase(_it->first);
+  return this->markers.erase(_it);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void MarkerManager::deleteMarker(unsigned int _id)
+void MarkerManager::deleteMarker(const std::string & _ns, int _id)
 {
-  auto it = visuals.find(_id);
-  if (it != visuals.end()) {
-    this->scene->DestroyVisual(it->second, true);
-    visuals.erase(_id);
+  auto it = this->markers.find(MarkerKey{_ns, _id});
+  if (it != this->markers.end()) {
+    this->destroyMarker(it);
   } else {
-    RCLCPP_WARN(rclcpp::get_logger("MarkerManager"), "Marker with id %d not found", _id);
+    RCLCPP_WARN(
+      rclcpp::get_logger("MarkerManager"), "Marker %s/%d not found", _ns.c_str(), _id);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MarkerManager::deleteAllMarkers()
 {
-  for (auto visual : visuals) {
-    this->scene->DestroyVisual(visual.second, true);
+  for (auto & marker : this->markers) {
+    this->scene->DestroyVisual(marker.second.frameVisual, true);
+    releaseMaterials(marker.second);
   }
-  visuals.clear();
+  this->markers.clear();
+  this->trackedMarkers.clear();
+  this->expiries = std::priority_queue<MarkerExpiry, std::vector<MarkerExpiry>,
+      std::greater<MarkerExpiry>>();
 }
 
 }  // namespace plugins
@@ -0,0 +1,114 @@
+// Copyright (c) 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ignition/rviz/plugins/MarkerQueue.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ignition
+{
+namespace rviz
+{
+namespace plugins
+{
+////////////////////////////////////////////////////////////////////////////////
+MarkerQueue::MarkerQueue(size_t _capacity)
+: capacity(_capacity), lastReceiveTime(0), droppedCount(0) {}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerQueue::post(MarkerPtr _marker, int64_t _receiveTime)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+  this->push(std::move(_marker));
+  this->lastReceiveTime = _receiveTime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerQueue::post(
+  const visualization_msgs::msg::MarkerArray::ConstSharedPtr & _msg,
+  int64_t _receiveTime)
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+  for (const auto & marker : _msg->markers) {
+    // Aliases the array, which stays alive while any of its markers is pending
+    this->push(MarkerPtr(_msg, &marker));
+  }
+  this->lastReceiveTime = _receiveTime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerQueue::push(MarkerPtr _marker)
+{
+  if (_marker->action == visualization_msgs::msg::Marker::DELETEALL) {
+    // Everything pending is deleted anyway
+    this->droppedCount += this->pending.size();
+    this->pending.clear();
+    this->index.clear();
+    this->pending.push_back(std::move(_marker));
+    return;
+  }
+
+  MarkerKey key{_marker->ns, _marker->id};
+  auto it = this->index.find(key);
+  if (it != this->index.end()) {
+    // Markers are independent, the latest message replaces the pending one in place
+    this->pending[it->second] = std::move(_marker);
+    this->droppedCount++;
+    return;
+  }
+
+  if (this->pending.size() >= this->capacity) {
+    this->droppedCount++;
+    return;
+  }
+
+  this->index.emplace(std::move(key), this->pending.size());
+  this->pending.push_back(std::move(_marker));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MarkerQueue::take(std::vector<MarkerPtr> & _markers, int64_t & _receiveTime)
+{
+  _markers.clear();
+
+  std::lock_guard<std::mutex> guard(this->mutex);
+  if (this->pending.empty()) {
+    return false;
+  }
+
+  _markers.swap(this->pending);
+  this->index.clear();
+  _receiveTime = this->lastReceiveTime;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarkerQueue::clear()
+{
+  std::lock_guard<std::mutex> guard(this->mutex);
+  this->pending.clear();
+  this->index.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+uint64_t MarkerQueue::dropped() const
+{
+  return this->droppedCount;
+}
+
+}  // namespace plugins
+}  // namespace rviz
+}  // namespace ignition
@@ -56,7 +56,7 @@ PathDisplay::PathDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 PathDisplay::~PathDisplay()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Delete visual
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->removeEventFilter(this);
   this->scene->DestroyVisual(this->rootVisual, true);
@@ -65,25 +65,26 @@ PathDisplay::~PathDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::initialize(rclcpp::Node::SharedPtr _node)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->node = std::move(_node);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::subscribe()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   this->subscriber = this->node->create_subscription<nav_msgs::msg::Path>(
     this->topic_name,
     this->qos,
-    std::bind(&PathDisplay::callback, this, std::placeholders::_1));
+    std::bind(&PathDisplay::callback, this, std::placeholders::_1),
+    this->subscriptionOptions());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::setTopic(const std::string & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name;
 
   this->subscribe();
@@ -95,7 +96,7 @@ void PathDisplay::setTopic(const std::string & topic_name)
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::setTopic(const QString & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name.toStdString();
 
   // Destroy previous subscription
@@ -107,17 +108,17 @@ void PathDisplay::setTopic(const QString & topic_name)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void PathDisplay::callback(const nav_msgs::msg::Path::SharedPtr _msg)
+void PathDisplay::callback(const nav_msgs::msg::Path::ConstSharedPtr _msg)
 {
-  std::lock_guard<std::mutex>(this->lock);
-  this->msg = std::move(_msg);
+  this->receive(_msg);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool PathDisplay::eventFilter(QObject * _object, QEvent * _event)
 {
-  if (_event->type() == gui::events::Render::kType) {
+  if (_event->type() == gui::events::Render::kType && this->beginUpdate()) {
     update();
+    this->endUpdate();
   }
 
   return QObject::eventFilter(_object, _event);
@@ -131,18 +132,28 @@ void PathDisplay::reset()
     this->axes[i]->SetLocalPose(math::Pose3d::Zero);
   }
 
+  this->mailbox.clear();
   this->msg.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::update()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
+
+  // Pick up the latest received message
+  auto latest = this->takeLatest();
+  if (latest) {
+    this->msg = latest;
+  }
 
   if (!this->msg) {
     return;
   }
 
+  // Keep pending changes until uploaded
+  this->dataChanged = this->dataChanged || latest || this->createMarker || this->dirty;
+
   if (this->createMarker) {
     // Delete previous marker geometry.
     this->rootVisual->RemoveGeometries();
@@ -160,7 +171,8 @@ void PathDisplay::update()
   }
 
   math::Pose3d visualPose;
-  bool poseAvailable = this->frameManager->getFramePose(this->msg->header.frame_id, visualPose);
+  bool poseAvailable = this->frameManager->getFramePose(
+    this->msg->header.frame_id, this->msg->header.stamp, visualPose);
 
   if (!poseAvailable) {
     RCLCPP_ERROR(
@@ -172,6 +184,12 @@ void PathDisplay::update()
   this->rootVisual->SetLocalPosition(visualPose.Pos() + this->offset);
   this->rootVisual->SetLocalRotation(visualPose.Rot());
 
+  // Geometry is unchanged, only the frame pose is updated
+  if (!this->uploadRequired(this->dataChanged)) {
+    return;
+  }
+  this->dataChanged = false;
+
   auto marker = std::dynamic_pointer_cast<rendering::Marker>(this->rootVisual->GeometryByIndex(0));
   marker->ClearPoints();
 
@@ -251,7 +269,7 @@ void PathDisplay::updateVisual(int _index)
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::setShape(const int & _shape)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->visualShape = _shape;
   this->dirty = true;
 }
@@ -259,7 +277,7 @@ void PathDisplay::setShape(const int & _shape)
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::setAxisHeadVisibility(const bool & _visible)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->axisHeadVisible = _visible;
   this->dirty = true;
 }
@@ -267,7 +285,7 @@ void PathDisplay::setAxisHeadVisibility(const bool & _visible)
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::setAxisDimensions(const float & _length, const float & _radius)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->axisLength = _length;
   this->axisRadius = _radius;
   this->dirty = true;
@@ -278,7 +296,7 @@ void PathDisplay::setArrowDimensions(
   const float & _shaftLength, const float & _shaftRadius,
   const float & _headLength, const float & _headRadius)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->shaftLength = _shaftLength;
   this->shaftRadius = _shaftRadius;
   this->headLength = _headLength;
@@ -289,7 +307,7 @@ void PathDisplay::setArrowDimensions(
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::setColor(const QColor & _color)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->mat->SetAmbient(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
   this->mat->SetDiffuse(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
   this->mat->SetEmissive(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
@@ -302,7 +320,7 @@ void PathDisplay::setColor(const QColor & _color)
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::setLineColor(const QColor & _color)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->color.Set(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
 
   // Recreating marker is the only way to change color and transparency
@@ -312,14 +330,14 @@ void PathDisplay::setLineColor(const QColor & _color)
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::setOffset(const float & _x, const float & _y, const float & _z)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->offset.Set(_x, _y, _z);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::setFrameManager(std::shared_ptr<common::FrameManager> _frameManager)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->frameManager = std::move(_frameManager);
 }
 
@@ -332,7 +350,7 @@ QStringList PathDisplay::getTopicList() const
 ////////////////////////////////////////////////////////////////////////////////
 void PathDisplay::onRefresh()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Clear
   this->topicList.clear();
@@ -340,17 +358,12 @@ void PathDisplay::onRefresh()
   int index = 0, position = 0;
 
   // Get topic list
-  auto topics = this->node->get_topic_names_and_types();
-  for (const auto & topic : topics) {
-    for (const auto & topicType : topic.second) {
-      if (topicType == "nav_msgs/msg/Path") {
-        this->topicList.push_back(QString::fromStdString(topic.first));
-        if (topic.first == this->topic_name) {
-          position = index;
-        }
-        index++;
-      }
+  for (const auto & topic : this->getTopicsByType("nav_msgs/msg/Path")) {
+    this->topicList.push_back(QString::fromStdString(topic));
+    if (topic == this->topic_name) {
+      position = index;
     }
+    index++;
   }
   // Update combo-box
   this->topicListChanged();
@@ -362,7 +375,7 @@ void PathDisplay::updateQoS(
   const int & _depth, const int & _history, const int & _reliability,
   const int & _durability)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->setHistoryDepth(_depth);
   this->setHistoryPolicy(_history);
   this->setReliabilityPolicy(_reliability);
@@ -50,7 +50,7 @@ PointStampedDisplay::PointStampedDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 PointStampedDisplay::~PointStampedDisplay()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Delete visual
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->removeEventFilter(this);
   this->scene->DestroyVisual(this->rootVisual, true);
@@ -59,25 +59,26 @@ PointStampedDisplay::~PointStampedDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 void PointStampedDisplay::initialize(rclcpp::Node::SharedPtr _node)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->node = std::move(_node);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PointStampedDisplay::subscribe()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   this->subscriber = this->node->create_subscription<geometry_msgs::msg::PointStamped>(
     this->topic_name,
     this->qos,
-    std::bind(&PointStampedDisplay::callback, this, std::placeholders::_1));
+    std::bind(&PointStampedDisplay::callback, this, std::placeholders::_1),
+    this->subscriptionOptions());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PointStampedDisplay::setTopic(const std::string & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name;
 
   this->subscribe();
@@ -89,7 +90,7 @@ void PointStampedDisplay::setTopic(const std::string & topic_name)
 ////////////////////////////////////////////////////////////////////////////////
 void PointStampedDisplay::setTopic(const QString & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name.toStdString();
 
   // Destroy previous subscription
@@ -101,17 +102,17 @@ void PointStampedDisplay::setTopic(const QString & topic_name)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void PointStampedDisplay::callback(const geometry_msgs::msg::PointStamped::SharedPtr _msg)
+void PointStampedDisplay::callback(const geometry_msgs::msg::PointStamped::ConstSharedPtr _msg)
 {
-  std::lock_guard<std::mutex>(this->lock);
-  this->msg = std::move(_msg);
+  this->receive(_msg);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool PointStampedDisplay::eventFilter(QObject * _object, QEvent * _event)
 {
-  if (_event->type() == gui::events::Render::kType) {
+  if (_event->type() == gui::events::Render::kType && this->beginUpdate()) {
     update();
+    this->endUpdate();
   }
 
   return QObject::eventFilter(_object, _event);
@@ -124,25 +125,33 @@ void PointStampedDisplay::reset()
     removeOldestPointVisual();
   }
 
+  this->mailbox.clear();
   this->msg.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PointStampedDisplay::update()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Remove visuals exceeding history length
   while (this->visuals.size() > this->historyLength) {
     this->removeOldestPointVisual();
   }
 
+  // Pick up the latest received message
+  auto latest = this->takeLatest();
+  if (latest) {
+    this->msg = std::move(latest);
+  }
+
   if (!this->msg) {
     return;
   }
 
   math::Pose3d pose;
-  bool poseAvailable = this->frameManager->getFramePose(this->msg->header.frame_id, pose);
+  bool poseAvailable = this->frameManager->getFramePose(
+    this->msg->header.frame_id, this->msg->header.stamp, pose);
 
   if (!poseAvailable) {
     RCLCPP_ERROR(
@@ -165,9 +174,9 @@ void PointStampedDisplay::update()
 
 ////////////////////////////////////////////////////////////////////////////////
 void PointStampedDisplay::createNewPointVisual(
-  const geometry_msgs::msg::PointStamped::SharedPtr _msg)
+  const geometry_msgs::msg::PointStamped::ConstSharedPtr _msg)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Create Visual
   auto visual = this->scene->CreateVisual();
   visual->AddGeometry(this->scene->CreateSphere());
@@ -192,14 +201,14 @@ void PointStampedDisplay::removeOldestPointVisual()
 ////////////////////////////////////////////////////////////////////////////////
 void PointStampedDisplay::setFrameManager(std::shared_ptr<common::FrameManager> _frameManager)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->frameManager = std::move(_frameManager);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PointStampedDisplay::setHistoryLength(const int & _length)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Update history length
   this->historyLength = _length;
 }
@@ -207,7 +216,7 @@ void PointStampedDisplay::setHistoryLength(const int & _length)
 ////////////////////////////////////////////////////////////////////////////////
 void PointStampedDisplay::setRadius(const float & _radius)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   for (const auto & visual : this->visuals) {
     visual->SetLocalScale(_radius);
   }
@@ -217,7 +226,7 @@ void PointStampedDisplay::setRadius(const float & _radius)
 ////////////////////////////////////////////////////////////////////////////////
 void PointStampedDisplay::setColor(const QColor & _color)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->mat->SetAmbient(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
   this->mat->SetDiffuse(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
   this->mat->SetEmissive(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
@@ -236,7 +245,7 @@ QStringList PointStampedDisplay::getTopicList() const
 ////////////////////////////////////////////////////////////////////////////////
 void PointStampedDisplay::onRefresh()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Clear
   this->topicList.clear();
@@ -244,17 +253,12 @@ void PointStampedDisplay::onRefresh()
   int index = 0, position = 0;
 
   // Get topic list
-  auto topics = this->node->get_topic_names_and_types();
-  for (const auto & topic : topics) {
-    for (const auto & topicType : topic.second) {
-      if (topicType == "geometry_msgs/msg/PointStamped") {
-        this->topicList.push_back(QString::fromStdString(topic.first));
-        if (topic.first == this->topic_name) {
-          position = index;
-        }
-        index++;
-      }
+  for (const auto & topic : this->getTopicsByType("geometry_msgs/msg/PointStamped")) {
+    this->topicList.push_back(QString::fromStdString(topic));
+    if (topic == this->topic_name) {
+      position = index;
     }
+    index++;
   }
   // Update combo-box
   this->topicListChanged();
@@ -266,7 +270,7 @@ void PointStampedDisplay::updateQoS(
   const int & _depth, const int & _history, const int & _reliability,
   const int & _durability)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->setHistoryDepth(_depth);
   this->setHistoryPolicy(_history);
   this->setReliabilityPolicy(_reliability);
@@ -45,7 +45,7 @@ PolygonDisplay::PolygonDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 PolygonDisplay::~PolygonDisplay()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Delete visual
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->removeEventFilter(this);
   this->scene->DestroyVisual(this->rootVisual, true);
@@ -54,25 +54,26 @@ PolygonDisplay::~PolygonDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 void PolygonDisplay::initialize(rclcpp::Node::SharedPtr _node)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->node = std::move(_node);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PolygonDisplay::subscribe()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   this->subscriber = this->node->create_subscription<geometry_msgs::msg::PolygonStamped>(
     this->topic_name,
     this->qos,
-    std::bind(&PolygonDisplay::callback, this, std::placeholders::_1));
+    std::bind(&PolygonDisplay::callback, this, std::placeholders::_1),
+    this->subscriptionOptions());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PolygonDisplay::setTopic(const std::string & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name;
 
   this->subscribe();
@@ -84,7 +85,7 @@ void PolygonDisplay::setTopic(const std::string & topic_name)
 ////////////////////////////////////////////////////////////////////////////////
 void PolygonDisplay::setTopic(const QString & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name.toStdString();
 
   // Destroy previous subscription
@@ -96,17 +97,17 @@ void PolygonDisplay::setTopic(const QString & topic_name)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void PolygonDisplay::callback(const geometry_msgs::msg::PolygonStamped::SharedPtr _msg)
+void PolygonDisplay::callback(const geometry_msgs::msg::PolygonStamped::ConstSharedPtr _msg)
 {
-  std::lock_guard<std::mutex>(this->lock);
-  this->msg = std::move(_msg);
+  this->receive(_msg);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool PolygonDisplay::eventFilter(QObject * _object, QEvent * _event)
 {
-  if (_event->type() == gui::events::Render::kType) {
+  if (_event->type() == gui::events::Render::kType && this->beginUpdate()) {
     update();
+    this->endUpdate();
   }
 
   return QObject::eventFilter(_object, _event);
@@ -115,6 +116,7 @@ bool PolygonDisplay::eventFilter(QObject * _object, QEvent * _event)
 ////////////////////////////////////////////////////////////////////////////////
 void PolygonDisplay::reset()
 {
+  this->mailbox.clear();
   this->msg.reset();
 
   auto marker = std::dynamic_pointer_cast<rendering::Marker>(this->rootVisual->GeometryByIndex(0));
@@ -132,12 +134,21 @@ void PolygonDisplay::reset()
 ////////////////////////////////////////////////////////////////////////////////
 void PolygonDisplay::update()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
+
+  // Pick up the latest received message
+  auto latest = this->takeLatest();
+  if (latest) {
+    this->msg = latest;
+  }
 
   if (!this->msg) {
     return;
   }
 
+  // Keep pending changes until uploaded
+  this->dataChanged = this->dataChanged || latest || this->createMarker;
+
   if (createMarker) {
     // Delete previous marker geometry.
     this->rootVisual->RemoveGeometries();
@@ -155,7 +166,8 @@ void PolygonDisplay::update()
   }
 
   math::Pose3d pose;
-  bool poseAvailable = this->frameManager->getFramePose(this->msg->header.frame_id, pose);
+  bool poseAvailable = this->frameManager->getFramePose(
+    this->msg->header.frame_id, this->msg->header.stamp, pose);
 
   if (!poseAvailable) {
     RCLCPP_ERROR(
@@ -164,6 +176,14 @@ void PolygonDisplay::update()
     return;
   }
 
+  this->rootVisual->SetLocalPose(pose);
+
+  // Polygon is unchanged, only the frame pose is updated
+  if (!this->uploadRequired(this->dataChanged)) {
+    return;
+  }
+  this->dataChanged = false;
+
   auto marker = std::dynamic_pointer_cast<rendering::Marker>(this->rootVisual->GeometryByIndex(0));
 
   marker->ClearPoints();
@@ -183,14 +203,12 @@ void PolygonDisplay::update()
   // Adding fist point again to close polygon
   const auto & point = this->msg->polygon.points.front();
   marker->AddPoint(point.x, point.y, point.z, this->color);
-
-  this->rootVisual->SetLocalPose(pose);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PolygonDisplay::setColor(const QColor & _color)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->color.Set(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
 
   // Recreating marker is the only way to change color and transparency
@@ -200,7 +218,7 @@ void PolygonDisplay::setColor(const QColor & _color)
 ////////////////////////////////////////////////////////////////////////////////
 void PolygonDisplay::setFrameManager(std::shared_ptr<common::FrameManager> _frameManager)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->frameManager = std::move(_frameManager);
 }
 
@@ -213,7 +231,7 @@ QStringList PolygonDisplay::getTopicList() const
 ////////////////////////////////////////////////////////////////////////////////
 void PolygonDisplay::onRefresh()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Clear
   this->topicList.clear();
@@ -221,17 +239,12 @@ void PolygonDisplay::onRefresh()
   int index = 0, position = 0;
 
   // Get topic list
-  auto topics = this->node->get_topic_names_and_types();
-  for (const auto & topic : topics) {
-    for (const auto & topicType : topic.second) {
-      if (topicType == "geometry_msgs/msg/PolygonStamped") {
-        this->topicList.push_back(QString::fromStdString(topic.first));
-        if (topic.first == this->topic_name) {
-          position = index;
-        }
-        index++;
-      }
+  for (const auto & topic : this->getTopicsByType("geometry_msgs/msg/PolygonStamped")) {
+    this->topicList.push_back(QString::fromStdString(topic));
+    if (topic == this->topic_name) {
+      position = index;
     }
+    index++;
   }
   // Update combo-box
   this->topicListChanged();
@@ -243,7 +256,7 @@ void PolygonDisplay::updateQoS(
   const int & _depth, const int & _history, const int & _reliability,
   const int & _durability)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->setHistoryDepth(_depth);
   this->setHistoryPolicy(_history);
   this->setReliabilityPolicy(_reliability);
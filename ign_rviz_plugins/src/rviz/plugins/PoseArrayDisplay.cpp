@@ -52,7 +52,7 @@ PoseArrayDisplay::PoseArrayDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 PoseArrayDisplay::~PoseArrayDisplay()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Delete visual
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->removeEventFilter(this);
   this->scene->DestroyVisual(this->rootVisual, true);
@@ -61,25 +61,26 @@ PoseArrayDisplay::~PoseArrayDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 void PoseArrayDisplay::initialize(rclcpp::Node::SharedPtr _node)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->node = std::move(_node);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PoseArrayDisplay::subscribe()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   this->subscriber = this->node->create_subscription<geometry_msgs::msg::PoseArray>(
     this->topic_name,
     this->qos,
-    std::bind(&PoseArrayDisplay::callback, this, std::placeholders::_1));
+    std::bind(&PoseArrayDisplay::callback, this, std::placeholders::_1),
+    this->subscriptionOptions());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PoseArrayDisplay::setTopic(const std::string & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name;
 
   this->subscribe();
@@ -91,7 +92,7 @@ void PoseArrayDisplay::setTopic(const std::string & topic_name)
 ////////////////////////////////////////////////////////////////////////////////
 void PoseArrayDisplay::setTopic(const QString & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name.toStdString();
 
   // Destroy previous subscription
@@ -103,17 +104,17 @@ void PoseArrayDisplay::setTopic(const QString & topic_name)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void PoseArrayDisplay::callback(const geometry_msgs::msg::PoseArray::SharedPtr _msg)
+void PoseArrayDisplay::callback(const geometry_msgs::msg::PoseArray::ConstSharedPtr _msg)
 {
-  std::lock_guard<std::mutex>(this->lock);
-  this->msg = std::move(_msg);
+  this->receive(_msg);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool PoseArrayDisplay::eventFilter(QObject * _object, QEvent * _event)
 {
-  if (_event->type() == gui::events::Render::kType) {
+  if (_event->type() == gui::events::Render::kType && this->beginUpdate()) {
     update();
+    this->endUpdate();
   }
 
   return QObject::eventFilter(_object, _event);
@@ -127,20 +128,31 @@ void PoseArrayDisplay::reset()
     this->axes[i]->SetLocalPose(math::Pose3d::Zero);
   }
 
+  this->mailbox.clear();
   this->msg.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PoseArrayDisplay::update()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
+
+  // Pick up the latest received message
+  auto latest = this->takeLatest();
+  if (latest) {
+    this->msg = latest;
+  }
 
   if (!this->msg) {
     return;
   }
 
+  // Keep pending changes until uploaded
+  this->dataChanged = this->dataChanged || latest || this->dirty;
+
   math::Pose3d visualPose;
-  bool poseAvailable = this->frameManager->getFramePose(this->msg->header.frame_id, visualPose);
+  bool poseAvailable = this->frameManager->getFramePose(
+    this->msg->header.frame_id, this->msg->header.stamp, visualPose);
 
   if (!poseAvailable) {
     RCLCPP_ERROR(
@@ -151,6 +163,12 @@ void PoseArrayDisplay::update()
 
   this->rootVisual->SetLocalPose(visualPose);
 
+  // Poses are unchanged, only the frame pose is updated
+  if (!this->uploadRequired(this->dataChanged)) {
+    return;
+  }
+  this->dataChanged = false;
+
   // Hide unused visuals. Faster than removing excess visuals and recreating them.
   for (auto i = this->msg->poses.size(); i < this->axes.size(); ++i) {
     this->axes[i]->SetVisible(false);
@@ -223,7 +241,7 @@ void PoseArrayDisplay::updateVisual(int _index)
 ////////////////////////////////////////////////////////////////////////////////
 void PoseArrayDisplay::setShape(const bool & _shape)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->visualShape = _shape;
   this->dirty = true;
 }
@@ -231,7 +249,7 @@ void PoseArrayDisplay::setShape(const bool & _shape)
 ////////////////////////////////////////////////////////////////////////////////
 void PoseArrayDisplay::setAxisHeadVisibility(const bool & _visible)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->axisHeadVisible = _visible;
   this->dirty = true;
 }
@@ -239,7 +257,7 @@ void PoseArrayDisplay::setAxisHeadVisibility(const bool & _visible)
 ////////////////////////////////////////////////////////////////////////////////
 void PoseArrayDisplay::setAxisDimensions(const float & _length, const float & _radius)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->axisLength = _length;
   this->axisRadius = _radius;
   this->dirty = true;
@@ -250,7 +268,7 @@ void PoseArrayDisplay::setArrowDimensions(
   const float & _shaftLength, const float & _shaftRadius,
   const float & _headLength, const float & _headRadius)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->shaftLength = _shaftLength;
   this->shaftRadius = _shaftRadius;
   this->headLength = _headLength;
@@ -261,7 +279,7 @@ void PoseArrayDisplay::setArrowDimensions(
 ////////////////////////////////////////////////////////////////////////////////
 void PoseArrayDisplay::setColor(const QColor & _color)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->mat->SetAmbient(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
   this->mat->SetDiffuse(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
   this->mat->SetEmissive(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
@@ -274,7 +292,7 @@ void PoseArrayDisplay::setColor(const QColor & _color)
 ////////////////////////////////////////////////////////////////////////////////
 void PoseArrayDisplay::setFrameManager(std::shared_ptr<common::FrameManager> _frameManager)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->frameManager = std::move(_frameManager);
 }
 
@@ -287,7 +305,7 @@ QStringList PoseArrayDisplay::getTopicList() const
 ////////////////////////////////////////////////////////////////////////////////
 void PoseArrayDisplay::onRefresh()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Clear
   this->topicList.clear();
@@ -295,17 +313,12 @@ void PoseArrayDisplay::onRefresh()
   int index = 0, position = 0;
 
   // Get topic list
-  auto topics = this->node->get_topic_names_and_types();
-  for (const auto & topic : topics) {
-    for (const auto & topicType : topic.second) {
-      if (topicType == "geometry_msgs/msg/PoseArray") {
-        this->topicList.push_back(QString::fromStdString(topic.first));
-        if (topic.first == this->topic_name) {
-          position = index;
-        }
-        index++;
-      }
+  for (const auto & topic : this->getTopicsByType("geometry_msgs/msg/PoseArray")) {
+    this->topicList.push_back(QString::fromStdString(topic));
+    if (topic == this->topic_name) {
+      position = index;
     }
+    index++;
   }
   // Update combo-box
   this->topicListChanged();
@@ -317,7 +330,7 @@ void PoseArrayDisplay::updateQoS(
   const int & _depth, const int & _history, const int & _reliability,
   const int & _durability)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->setHistoryDepth(_depth);
   this->setHistoryPolicy(_history);
   this->setReliabilityPolicy(_reliability);
@@ -51,7 +51,7 @@ PoseDisplay::PoseDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 PoseDisplay::~PoseDisplay()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Delete visual
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->removeEventFilter(this);
   this->scene->DestroyVisual(this->rootVisual, true);
@@ -60,25 +60,26 @@ PoseDisplay::~PoseDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 void PoseDisplay::initialize(rclcpp::Node::SharedPtr _node)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->node = std::move(_node);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PoseDisplay::subscribe()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   this->subscriber = this->node->create_subscription<geometry_msgs::msg::PoseStamped>(
     this->topic_name,
     this->qos,
-    std::bind(&PoseDisplay::callback, this, std::placeholders::_1));
+    std::bind(&PoseDisplay::callback, this, std::placeholders::_1),
+    this->subscriptionOptions());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PoseDisplay::setTopic(const std::string & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name;
 
   this->subscribe();
@@ -90,7 +91,7 @@ void PoseDisplay::setTopic(const std::string & topic_name)
 ////////////////////////////////////////////////////////////////////////////////
 void PoseDisplay::setTopic(const QString & topic_name)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name.toStdString();
 
   // Destroy previous subscription
@@ -102,17 +103,17 @@ void PoseDisplay::setTopic(const QString & topic_name)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void PoseDisplay::callback(const geometry_msgs::msg::PoseStamped::SharedPtr _msg)
+void PoseDisplay::callback(const geometry_msgs::msg::PoseStamped::ConstSharedPtr _msg)
 {
-  std::lock_guard<std::mutex>(this->lock);
-  this->msg = std::move(_msg);
+  this->receive(_msg);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool PoseDisplay::eventFilter(QObject * _object, QEvent * _event)
 {
-  if (_event->type() == gui::events::Render::kType) {
+  if (_event->type() == gui::events::Render::kType && this->beginUpdate()) {
     update();
+    this->endUpdate();
   }
 
   return QObject::eventFilter(_object, _event);
@@ -123,13 +124,14 @@ void PoseDisplay::reset()
 {
   this->arrow.visual->SetLocalPose(math::Pose3d::Zero);
   this->axis.visual->SetLocalPose(math::Pose3d::Zero);
+  this->mailbox.clear();
   this->msg.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void PoseDisplay::update()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Create axis
   if (this->axis.visual == nullptr) {
     this->axis.visual = this->scene->CreateAxisVisual();
@@ -156,12 +158,19 @@ void PoseDisplay::update()
     this->dirty = false;
   }
 
+  // Pick up the latest received message
+  auto latest = this->takeLatest();
+  if (latest) {
+    this->msg = std::move(latest);
+  }
+
   if (!this->msg) {
     return;
   }
 
   math::Pose3d pose;
-  bool poseAvailable = this->frameManager->getFramePose(this->msg->header.frame_id, pose);
+  bool poseAvailable = this->frameManager->getFramePose(
+    this->msg->header.frame_id, this->msg->header.stamp, pose);
 
   if (!poseAvailable) {
     RCLCPP_ERROR(
@@ -185,7 +194,7 @@ void PoseDisplay::update()
 ////////////////////////////////////////////////////////////////////////////////
 void PoseDisplay::setShape(const bool & _shape)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->visualShape = _shape;
   this->dirty = true;
 }
@@ -193,7 +202,7 @@ void PoseDisplay::setShape(const bool & _shape)
 ////////////////////////////////////////////////////////////////////////////////
 void PoseDisplay::setAxisHeadVisibility(const bool & _visible)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->axis.headVisible = _visible;
   this->dirty = true;
 }
@@ -201,7 +210,7 @@ void PoseDisplay::setAxisHeadVisibility(const bool & _visible)
 ////////////////////////////////////////////////////////////////////////////////
 void PoseDisplay::setAxisDimensions(const float & _length, const float & _radius)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->axis.length = _length;
   this->axis.radius = _radius;
   this->dirty = true;
@@ -212,7 +221,7 @@ void PoseDisplay::setArrowDimensions(
   const float & _shaftLength, const float & _shaftRadius,
   const float & _headLength, const float & _headRadius)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->arrow.shaftLength = _shaftLength;
   this->arrow.shaftRadius = _shaftRadius;
   this->arrow.headLength = _headLength;
@@ -223,7 +232,7 @@ void PoseDisplay::setArrowDimensions(
 ////////////////////////////////////////////////////////////////////////////////
 void PoseDisplay::setColor(const QColor & _color)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->arrow.mat->SetAmbient(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
   this->arrow.mat->SetDiffuse(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
   this->arrow.mat->SetEmissive(_color.redF(), _color.greenF(), _color.blueF(), _color.alphaF());
@@ -234,7 +243,7 @@ void PoseDisplay::setColor(const QColor & _color)
 ////////////////////////////////////////////////////////////////////////////////
 void PoseDisplay::setFrameManager(std::shared_ptr<common::FrameManager> _frameManager)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->frameManager = std::move(_frameManager);
 }
 
@@ -247,7 +256,7 @@ QStringList PoseDisplay::getTopicList() const
 ////////////////////////////////////////////////////////////////////////////////
 void PoseDisplay::onRefresh()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Clear
   this->topicList.clear();
@@ -255,17 +264,12 @@ void PoseDisplay::onRefresh()
   int index = 0, position = 0;
 
   // Get topic list
-  auto topics = this->node->get_topic_names_and_types();
-  for (const auto & topic : topics) {
-    for (const auto & topicType : topic.second) {
-      if (topicType == "geometry_msgs/msg/PoseStamped") {
-        this->topicList.push_back(QString::fromStdString(topic.first));
-        if (topic.first == this->topic_name) {
-          position = index;
-        }
-        index++;
-      }
+  for (const auto & topic : this->getTopicsByType("geometry_msgs/msg/PoseStamped")) {
+    this->topicList.push_back(QString::fromStdString(topic));
+    if (topic == this->topic_name) {
+      position = index;
     }
+    index++;
   }
   // Update combo-box
   this->topicListChanged();
@@ -277,7 +281,7 @@ void PoseDisplay::updateQoS(
   const int & _depth, const int & _history, const int & _reliability,
   const int & _durability)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->setHistoryDepth(_depth);
   this->setHistoryPolicy(_history);
   this->setReliabilityPolicy(_reliability);
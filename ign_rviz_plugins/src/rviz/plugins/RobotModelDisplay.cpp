@@ -107,7 +107,7 @@ RobotModelDisplay::RobotModelDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 RobotModelDisplay::~RobotModelDisplay()
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Delete visual
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->removeEventFilter(this);
   this->scene->DestroyVisual(this->rootVisual, true);
@@ -116,7 +116,7 @@ RobotModelDisplay::~RobotModelDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::initialize(rclcpp::Node::SharedPtr _node)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->node = std::move(_node);
 
   this->qos = this->qos.keep_last(1).transient_local();
@@ -125,7 +125,7 @@ void RobotModelDisplay::initialize(rclcpp::Node::SharedPtr _node)
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::setFrameManager(std::shared_ptr<common::FrameManager> _frameManager)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->frameManager = std::move(_frameManager);
 }
 
@@ -135,13 +135,14 @@ void RobotModelDisplay::subscribe()
   this->subscriber = this->node->create_subscription<std_msgs::msg::String>(
     this->topic_name,
     this->qos,
-    std::bind(&RobotModelDisplay::callback, this, std::placeholders::_1));
+    std::bind(&RobotModelDisplay::callback, this, std::placeholders::_1),
+    this->subscriptionOptions());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::setTopic(const std::string & topic_name)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name;
 
   this->subscribe();
@@ -153,7 +154,7 @@ void RobotModelDisplay::setTopic(const std::string & topic_name)
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::setTopic(const QString & topic_name)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->topic_name = topic_name.toStdString();
 
   // Destroy previous subscription
@@ -165,29 +166,22 @@ void RobotModelDisplay::setTopic(const QString & topic_name)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void RobotModelDisplay::callback(const std_msgs::msg::String::SharedPtr _msg)
+void RobotModelDisplay::callback(const std_msgs::msg::String::ConstSharedPtr _msg)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
   if (!_msg) {
     return;
   }
 
-  this->msg = std::move(_msg);
-
-  if (!this->robotModel.initString(this->msg->data)) {
-    RCLCPP_ERROR(this->node->get_logger(), "FAILED TO LOAD THE URDF STRING");
-  } else {
-    this->destroyModel = true;
-    this->modelLoaded = false;
-  }
+  this->receive(_msg);
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////
 bool RobotModelDisplay::eventFilter(QObject * _object, QEvent * _event)
 {
-  if (_event->type() == gui::events::Render::kType) {
+  if (_event->type() == gui::events::Render::kType && this->beginUpdate()) {
     update();
+    this->endUpdate();
   }
 
   return QObject::eventFilter(_object, _event);
@@ -196,7 +190,20 @@ bool RobotModelDisplay::eventFilter(QObject * _object, QEvent * _event)
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::update()
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
+
+  // Parse the latest received robot description
+  auto latest = this->takeLatest();
+  if (latest) {
+    this->msg = std::move(latest);
+
+    if (!this->robotModel.initString(this->msg->data)) {
+      RCLCPP_ERROR(this->node->get_logger(), "FAILED TO LOAD THE URDF STRING");
+    } else {
+      this->destroyModel = true;
+      this->modelLoaded = false;
+    }
+  }
 
   if (this->destroyModel) {
     // Recursively destroy all visuals
@@ -279,7 +286,7 @@ void RobotModelDisplay::update()
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::loadRobotModel()
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   if (this->rootVisual == nullptr) {
     this->rootVisual = this->scene->CreateVisual();
@@ -319,7 +326,7 @@ void RobotModelDisplay::loadRobotModel()
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::addLink(const urdf::LinkSharedPtr & _link)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   createLink(_link.get());
 
@@ -331,7 +338,7 @@ void RobotModelDisplay::addLink(const urdf::LinkSharedPtr & _link)
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::createLink(const urdf::Link * _link)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   RobotLinkProperties robotLink;
 
   // Add visual for link visual element
@@ -476,14 +483,14 @@ rendering::VisualPtr RobotModelDisplay::createLinkGeometry(
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::reset()
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->destroyModel = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::sourceChanged(const int & _source)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Clear tree view
   this->parentRow->removeRows(0, parentRow->rowCount());
   robotLinkModelChanged();
@@ -502,7 +509,7 @@ void RobotModelDisplay::sourceChanged(const int & _source)
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::openFile(const QString & _file)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Reset model visualziation
   this->destroyModel = true;
   // Clear tree view
@@ -529,21 +536,21 @@ void RobotModelDisplay::openFile(const QString & _file)
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::visualEnabled(const bool & _enabled)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->showVisual = _enabled;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::collisionEnabled(const bool & _enabled)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->showCollision = _enabled;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::setAlpha(const float & _alpha)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->alpha = _alpha;
   this->dirty = true;
 }
@@ -551,7 +558,7 @@ void RobotModelDisplay::setAlpha(const float & _alpha)
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::setLinkVisibility(const QString & _link, const bool & _visible)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   if (_link == "All Links") {
     // Update frame GUI checkboxes
@@ -590,7 +597,7 @@ QStringList RobotModelDisplay::getTopicList() const
 ////////////////////////////////////////////////////////////////////////////////
 void RobotModelDisplay::onRefresh()
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Clear
   this->topicList.clear();
@@ -598,17 +605,12 @@ void RobotModelDisplay::onRefresh()
   int index = 0, position = 0;
 
   // Get topic list
-  auto topics = this->node->get_topic_names_and_types();
-  for (const auto & topic : topics) {
-    for (const auto & topicType : topic.second) {
-      if (topicType == "std_msgs/msg/String") {
-        this->topicList.push_back(QString::fromStdString(topic.first));
-        if (topic.first == this->topic_name) {
-          position = index;
-        }
-        index++;
-      }
+  for (const auto & topic : this->getTopicsByType("std_msgs/msg/String")) {
+    this->topicList.push_back(QString::fromStdString(topic));
+    if (topic == this->topic_name) {
+      position = index;
     }
+    index++;
   }
   // Update combo-box
   this->topicListChanged();
@@ -620,7 +622,7 @@ void RobotModelDisplay::updateQoS(
   const int & _depth, const int & _history, const int & _reliability,
   const int & _durability)
 {
-  std::lock_guard<std::recursive_mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->setHistoryDepth(_depth);
   this->setHistoryPolicy(_history);
   this->setReliabilityPolicy(_reliability);
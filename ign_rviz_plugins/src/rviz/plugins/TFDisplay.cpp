@@ -124,7 +124,7 @@ TFDisplay::TFDisplay()
 ////////////////////////////////////////////////////////////////////////////////
 TFDisplay::~TFDisplay()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   // Delete visual
   ignition::gui::App()->findChild<ignition::gui::MainWindow *>()->removeEventFilter(this);
   this->scene->DestroyVisual(this->tfRootVisual);
@@ -206,7 +206,10 @@ bool TFDisplay::eventFilter(QObject * _object, QEvent * _event)
       tfRootVisual->AddChild(visualFrame);
     }
 
-    update();
+    if (this->beginUpdate()) {
+      update();
+      this->endUpdate();
+    }
   }
 
   if (_event->type() == rviz::events::FrameListChanged::kType) {
@@ -220,7 +223,7 @@ bool TFDisplay::eventFilter(QObject * _object, QEvent * _event)
 ////////////////////////////////////////////////////////////////////////////////
 void TFDisplay::update()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   // Create tf visual frames
   for (int i = tfRootVisual->ChildCount(); i < static_cast<int>(frameInfo.size()); ++i) {
@@ -228,6 +231,13 @@ void TFDisplay::update()
     this->tfRootVisual->AddChild(visualFrame);
   }
 
+  // Hide visuals left over from evicted frames
+  for (unsigned int j = frameInfo.size(); j < this->tfRootVisual->ChildCount(); ++j) {
+    rendering::VisualPtr visualFrame = std::dynamic_pointer_cast<rendering::Visual>(
+      this->tfRootVisual->ChildByIndex(j));
+    visualFrame->SetVisible(false);
+  }
+
   int i = -1;
   // Update tf visual frames
   for (const auto & frame : frameInfo) {
@@ -307,25 +317,27 @@ void TFDisplay::setFrameManager(std::shared_ptr<common::FrameManager> _frameMana
 ////////////////////////////////////////////////////////////////////////////////
 void TFDisplay::refresh()
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   std::vector<std::string> frames;
   this->frameManager->getFrames(frames);
 
-  if (frames.size() > 0) {
-    for (const auto frame : frames) {
-      this->frameInfo.insert({frame, true});
-    }
+  // Drop evicted frames, keep visibility of existing frames
+  std::map<std::string, bool> updatedFrameInfo;
+  for (const auto & frame : frames) {
+    auto it = this->frameInfo.find(frame);
+    updatedFrameInfo.insert({frame, it == this->frameInfo.end() || it->second});
+  }
+  this->frameInfo.swap(updatedFrameInfo);
 
-    // Clear rows
-    parentRow->removeRows(0, parentRow->rowCount());
+  // Clear rows
+  parentRow->removeRows(0, parentRow->rowCount());
 
-    for (auto frame : frameInfo) {
-      this->frameModel->addFrame(QString::fromStdString(frame.first), parentRow);
-    }
-    // Notify model update
-    frameModelChanged();
+  for (auto frame : frameInfo) {
+    this->frameModel->addFrame(QString::fromStdString(frame.first), parentRow);
   }
+  // Notify model update
+  frameModelChanged();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -339,42 +351,42 @@ void TFDisplay::LoadConfig(const tinyxml2::XMLElement * /*_pluginElem*/)
 ////////////////////////////////////////////////////////////////////////////////
 void TFDisplay::showAxes(const bool & _visible)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->axesVisible = _visible;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void TFDisplay::showNames(const bool & _visible)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->namesVisible = _visible;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void TFDisplay::showArrows(const bool & _visible)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->arrowsVisible = _visible;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void TFDisplay::showAxesHead(const bool & _visible)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->axesHeadVisible = _visible;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void TFDisplay::setMarkerScale(const float & _scale)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
   this->markerScale = _scale * 0.4;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void TFDisplay::setFrameVisibility(const QString & _frame, const bool & _visible)
 {
-  std::lock_guard<std::mutex>(this->lock);
+  std::lock_guard<std::recursive_mutex> guard(this->lock);
 
   if (_frame == "All Frames") {
     // Update frame GUI checkboxes